@@ -175,6 +175,7 @@ public class PsicroAddIn : IExcelAddIn
     // Carichiamo la funzione per la quota dalla tua DLL C
     [DllImport("psicro.dll", CallingConvention = CallingConvention.StdCall)]public static extern double Excel_set_quota(double altitude);
     //[DllImport(DLL_PATH, CallingConvention = CallingConvention.StdCall)] public static extern double Excel_get_patm_at_altitude(double altitude);
+    [DllImport(DLL_PATH, CallingConvention = CallingConvention.StdCall)] public static extern double Excel_set_precisione(double profilo);
     
     [DllImport(DLL_PATH, CallingConvention = CallingConvention.StdCall)] public static extern double Excel_Psat(double t);
     [DllImport(DLL_PATH, CallingConvention = CallingConvention.StdCall)] public static extern double Excel_TPsat(double p_kpa);
@@ -705,6 +706,23 @@ public class PsicroAddIn : IExcelAddIn
         }
     }
 
+    [ExcelFunction(Name = "PSICRO.SET.PRECISIONE", Description = "Imposta la precisione dei calcoli iterativi / Set solver accuracy", Category = "Psicrometria", IsVolatile = true)]
+    public static string PSICRO_SET_PRECISIONE(
+        [ExcelArgument(Description = "RIFERIMENTO (default), STANDARD (1e-6 K), INGEGNERIA (1e-3 K)")] object profilo)
+    {
+        string p = (profilo == null || profilo is ExcelMissing || profilo is ExcelEmpty) ? "RIFERIMENTO" : profilo.ToString().Trim().ToUpper();
+        int idx;
+        switch (p)
+        {
+            case "RIFERIMENTO": case "REFERENCE": case "0": idx = 0; break;
+            case "STANDARD": case "1": idx = 1; break;
+            case "INGEGNERIA": case "ENGINEERING": case "2": idx = 2; break;
+            default: return "Errore: profilo non valido / Error: invalid profile (" + p + ")";
+        }
+        double r = Excel_set_precisione(idx);
+        return (r < 0) ? "Errore/Error: " + r : "Precisione/Accuracy: " + p;
+    }
+
     [ExcelFunction(Name = "PSICRO.HELP", Description = "Guida rapida alle funzioni / Quick help guide", Category = "Psicrometria")]
     public static string Psicro_Help()
     {
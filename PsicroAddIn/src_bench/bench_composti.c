@@ -0,0 +1,133 @@
+// Costo dei percorsi composti: nucleo inline contro catena di chiamate esportate.
+// Uso: bench_composti [-n righe] [-r ripetizioni]
+// Per ogni funzione composta: ns per chiamata della funzione esportata (che
+// compone i core_* inline in psicro_core.h) e della stessa composizione fatta
+// con le funzioni esportate, come prima della separazione del nucleo;
+// migliore delle ripetizioni, seriale. Lo scarto massimo fra i due percorsi
+// deve essere 0.
+#include "../src_c_dll/psicrometria.h"
+#include "../src_c_dll/psicro_thread.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- COMPOSIZIONI PER CHIAMATE ESPORTATE ---
+static double PSICRO_CALL es_vau_ur_tbu(double ur, double tbu) {
+    double t = t_ur_tbu(ur, tbu);
+    double x = x_ur_tbu(ur, tbu);
+    return vau_t_x(t, x);
+}
+static double PSICRO_CALL es_vau_h_tbu(double h, double tbu) {
+    double x = x_h_tbu(h, tbu);
+    double t = t_h_tbu(h, tbu);
+    return vau_t_x(t, x);
+}
+static double PSICRO_CALL es_tbu_ur_vau(double ur, double vau) {
+    double x = x_ur_vau(ur, vau);
+    double h = h_ur_vau(ur, vau);
+    return tbu_x_h(x, h);
+}
+static double PSICRO_CALL es_h_ur_tbu(double ur, double tbu) {
+    double t = t_ur_tbu(ur, tbu);
+    return h_t_ur(t, ur);
+}
+static double PSICRO_CALL es_tbu_t_ur(double t, double ur) {
+    if (fabs(ur - 100.0) <= 0.00001) return t;
+    double x = x_t_ur(t, ur);
+    double h = h_t_ur(t, ur);
+    return tbu_x_h(x, h);
+}
+static double PSICRO_CALL es_vau_h_tr(double h, double tr) {
+    double x = x_t_ur(tr, 100);
+    double t = t_x_h(x, h);
+    return vau_t_x(t, x);
+}
+static double PSICRO_CALL es_tr_ur_x(double ur, double x) {
+    if ((x <= 0.0) || (ur <= 0.001)) return -273.15;
+    if (ur >= 100.0) return t_ur_x(100, x);
+    double t_calc = t_ur_x(ur, x);
+    double ur_calc = ur_t_x(t_calc, x);
+    return tr_t_ur(t_calc, ur_calc);
+}
+
+typedef struct {
+    const char* nome;
+    psicro_fn nucleo, esportate;
+    int id1, id2;
+} caso;
+
+static const caso casi[] = {
+    { "vau_ur_tbu", vau_ur_tbu, es_vau_ur_tbu, PSICRO_UR, PSICRO_TBU },
+    { "vau_h_tbu",  vau_h_tbu,  es_vau_h_tbu,  PSICRO_H,  PSICRO_TBU },
+    { "tbu_ur_vau", tbu_ur_vau, es_tbu_ur_vau, PSICRO_UR, PSICRO_VAU },
+    { "h_ur_tbu",   h_ur_tbu,   es_h_ur_tbu,   PSICRO_UR, PSICRO_TBU },
+    { "tbu_t_ur",   tbu_t_ur,   es_tbu_t_ur,   PSICRO_T,  PSICRO_UR },
+    { "vau_h_tr",   vau_h_tr,   es_vau_h_tr,   PSICRO_H,  PSICRO_TR },
+    { "tr_ur_x",    tr_ur_x,    es_tr_ur_x,    PSICRO_UR, PSICRO_X },
+};
+
+static double misura(psicro_fn fn, const double* v1, const double* v2, long long n, int ripetizioni, double* out) {
+    double migliore = HUGE_VAL;
+    for (int r = 0; r < ripetizioni; r++) {
+        unsigned long long t0 = psicro_ora_ns();
+        for (long long i = 0; i < n; i++) out[i] = fn(v1[i], v2[i]);
+        double ns = (double)(psicro_ora_ns() - t0) / (double)n;
+        if (ns < migliore) migliore = ns;
+    }
+    return migliore;
+}
+
+int main(int argc, char** argv) {
+    long long n = 100000;
+    int ripetizioni = 7;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-n") == 0) n = atoll(argv[i + 1]);
+        else if (strcmp(argv[i], "-r") == 0) ripetizioni = atoi(argv[i + 1]);
+        else {
+            fprintf(stderr, "uso: %s [-n righe] [-r ripetizioni]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (n <= 0 || ripetizioni < 1) return 2;
+
+    // Stati (t, ur) su -20..50 °C, 5..95 % e le grandezze derivate
+    double* v[PSICRO_N_PROP];
+    for (int p = 0; p < PSICRO_N_PROP; p++) {
+        v[p] = (double*)malloc((size_t)n * sizeof(double));
+        if (v[p] == NULL) return 1;
+    }
+    double* a = (double*)malloc((size_t)n * sizeof(double));
+    double* b = (double*)malloc((size_t)n * sizeof(double));
+    if (!a || !b) return 1;
+    for (long long i = 0; i < n; i++) {
+        const double t = -20.0 + 70.0 * (double)((i * 7919) % n) / (double)n;
+        const double ur = 5.0 + 90.0 * (double)((i * 104729) % n) / (double)n;
+        v[PSICRO_T][i] = t;
+        v[PSICRO_UR][i] = ur;
+        v[PSICRO_X][i] = x_t_ur(t, ur);
+        v[PSICRO_H][i] = h_t_ur(t, ur);
+        v[PSICRO_VAU][i] = vau_t_ur(t, ur);
+        v[PSICRO_TBU][i] = tbu_t_ur(t, ur);
+        v[PSICRO_TR][i] = tr_t_ur(t, ur);
+    }
+
+    printf("bench_composti: %lld righe, migliore di %d, PATM %.3f kPa\n", n, ripetizioni, PATM);
+    printf("%-12s | %10s | %10s | %7s | %s\n", "funzione", "nucleo", "esportate", "guad.", "scarto max");
+    for (size_t k = 0; k < sizeof(casi) / sizeof(casi[0]); k++) {
+        const caso* c = &casi[k];
+        const double ns_es = misura(c->esportate, v[c->id1], v[c->id2], n, ripetizioni, b);
+        const double ns_nu = misura(c->nucleo, v[c->id1], v[c->id2], n, ripetizioni, a);
+        double scarto = 0.0;
+        for (long long i = 0; i < n; i++) {
+            // NaN su un solo percorso rende NaN lo scarto
+            const double d = (isnan(a[i]) && isnan(b[i])) ? 0.0 : fabs(a[i] - b[i]);
+            if (!(d <= scarto)) scarto = d;
+        }
+        printf("%-12s | %7.1f ns | %7.1f ns | %6.2fx | %.1e\n", c->nome, ns_nu, ns_es, ns_es / ns_nu, scarto);
+    }
+    for (int p = 0; p < PSICRO_N_PROP; p++) free(v[p]);
+    free(a);
+    free(b);
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Velocità dei solutori iterativi per profilo di precisione.
+// Uso: bench_precisione [-n righe] [-r ripetizioni]
+// Per ogni funzione e profilo: ns per chiamata (seriale, migliore delle
+// ripetizioni), accelerazione rispetto a RIFERIMENTO e scarto massimo dal
+// riferimento.
+#include "../src_c_dll/psicro_precisione.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char* nome;
+    int target, id1, id2;
+} caso;
+
+static const caso casi[] = {
+    { "tbu(t, ur)",  PSICRO_TBU, PSICRO_T,  PSICRO_UR },
+    { "tbu(x, h)",   PSICRO_TBU, PSICRO_X,  PSICRO_H },
+    { "tr(t, ur)",   PSICRO_TR,  PSICRO_T,  PSICRO_UR },
+    { "t(ur, h)",    PSICRO_T,   PSICRO_UR, PSICRO_H },
+    { "t(ur, vau)",  PSICRO_T,   PSICRO_UR, PSICRO_VAU },
+    { "t(ur, tbu)",  PSICRO_T,   PSICRO_UR, PSICRO_TBU },
+};
+static const char* nomi_prec[PSICRO_N_PREC] = { "RIFERIMENTO", "STANDARD", "INGEGNERIA" };
+
+// ns per chiamata, migliore delle ripetizioni
+static double misura(const caso* c, const double* v1, const double* v2, long long n, int prof, int ripetizioni, double* out) {
+    double migliore = HUGE_VAL;
+    for (int r = 0; r < ripetizioni; r++) {
+        unsigned long long t0 = psicro_ora_ns();
+        for (long long i = 0; i < n; i++) out[i] = psicro_calc_prec(c->target, c->id1, v1[i], c->id2, v2[i], prof);
+        double ns = (double)(psicro_ora_ns() - t0) / (double)n;
+        if (ns < migliore) migliore = ns;
+    }
+    return migliore;
+}
+
+int main(int argc, char** argv) {
+    long long n = 200000;
+    int ripetizioni = 5;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-n") == 0) n = atoll(argv[i + 1]);
+        else if (strcmp(argv[i], "-r") == 0) ripetizioni = atoi(argv[i + 1]);
+        else {
+            fprintf(stderr, "uso: %s [-n righe] [-r ripetizioni]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (n <= 0 || ripetizioni < 1) return 2;
+
+    // Stati (t, ur) su -20..50 °C, 5..95 % e le grandezze derivate
+    double* v[PSICRO_N_PROP];
+    for (int p = 0; p < PSICRO_N_PROP; p++) {
+        v[p] = (double*)malloc((size_t)n * sizeof(double));
+        if (v[p] == NULL) return 1;
+    }
+    double* rif = (double*)malloc((size_t)n * sizeof(double));
+    double* out = (double*)malloc((size_t)n * sizeof(double));
+    if (!rif || !out) return 1;
+    for (long long i = 0; i < n; i++) {
+        const double t = -20.0 + 70.0 * (double)((i * 7919) % n) / (double)n;
+        const double ur = 5.0 + 90.0 * (double)((i * 104729) % n) / (double)n;
+        v[PSICRO_T][i] = t;
+        v[PSICRO_UR][i] = ur;
+        v[PSICRO_X][i] = x_t_ur(t, ur);
+        v[PSICRO_H][i] = h_t_ur(t, ur);
+        v[PSICRO_VAU][i] = vau_t_ur(t, ur);
+        v[PSICRO_TBU][i] = tbu_t_ur(t, ur);
+        v[PSICRO_TR][i] = tr_t_ur(t, ur);
+    }
+
+    printf("bench_precisione: %lld righe, migliore di %d, PATM %.3f kPa\n", n, ripetizioni, PATM);
+    printf("%-12s", "funzione");
+    for (int p = 0; p < PSICRO_N_PREC; p++) printf(" | %-27s", nomi_prec[p]);
+    printf("\n");
+    for (size_t k = 0; k < sizeof(casi) / sizeof(casi[0]); k++) {
+        const caso* c = &casi[k];
+        const double ns_rif = misura(c, v[c->id1], v[c->id2], n, PSICRO_PREC_RIFERIMENTO, ripetizioni, rif);
+        printf("%-12s | %7.1f ns%17s", c->nome, ns_rif, "");
+        for (int p = PSICRO_PREC_RIFERIMENTO + 1; p < PSICRO_N_PREC; p++) {
+            const double ns = misura(c, v[c->id1], v[c->id2], n, p, ripetizioni, out);
+            double scarto = 0.0;
+            for (long long i = 0; i < n; i++) {
+                const double d = fabs(out[i] - rif[i]);
+                if (d > scarto) scarto = d;
+            }
+            printf(" | %7.1f ns %5.2fx (%7.1e)", ns, ns_rif / ns, scarto);
+        }
+        printf("\n");
+    }
+    for (int p = 0; p < PSICRO_N_PROP; p++) free(v[p]);
+    free(rif);
+    free(out);
+    return 0;
+}
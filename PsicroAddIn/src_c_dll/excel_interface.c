@@ -1,6 +1,7 @@
 
 #include <windows.h>
 #include "psicrometria.h"
+#include "psicro_precisione.h"
 #include <math.h>
 
 // Usiamo extern "C" per assicurarci che i nomi non vengano alterati dal compilatore C++
@@ -13,6 +14,11 @@ extern "C" {
 	__declspec(dllexport) double WINAPI Excel_set_quota(double altitude) {
 		set_patm_at_altitude(altitude);
 		return PATM;	}
+	__declspec(dllexport) double WINAPI Excel_set_precisione(double profilo) {
+		// Il cast a int di un double fuori campo o NaN non  definito: si verifica prima
+		if (!(profilo >= 0.0 && profilo < PSICRO_N_PREC)) return (double)PSICRO_ERR_ARG;
+		return (double)psicro_set_precisione((int)profilo);
+	}
 	/*
 	PSICRO_API Excel_set_quota(double altitude) {
 		set_patm_at_altitude(altitude);
@@ -0,0 +1,358 @@
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicro_autotaratura.h"
+#include "psicro_precisione.h"
+#include "psicro_tabelle.h"
+#include "psicro_thread.h"
+#include "psicro_core.h"
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define PSICRO_CPUID_MSVC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#include <cpuid.h>
+	#define PSICRO_CPUID_GCC
+#endif
+
+typedef struct {
+    int variante;
+    int profilo;        // -1 = profilo di processo
+    double ns_riga;
+    long long soglia_par;
+} voce_taratura;
+
+static psicro_mutex mtx_taratura = PSICRO_MUTEX_INIT;
+static voce_taratura scelte[PSICRO_N_PROP][PSICRO_N_PROP][PSICRO_N_PROP];   // [target][id1 < id2][id2]
+static int tarata = 0;
+
+// Unità di scala dell'errore per grandezza: 1 K, 1 %, 1 g/kg, 1 kJ/kg, 1 L/kg, 1 K, 1 K
+static const double scala[PSICRO_N_PROP] = { 1.0, 1.0, 1e-3, 1.0, 1e-3, 1.0, 1.0 };
+
+// --- IMPRONTA DELL'HOST ---
+static void cpuid(unsigned int foglia, unsigned int sotto, unsigned int r[4]) {
+#if defined(PSICRO_CPUID_MSVC)
+    int q[4];
+    __cpuidex(q, (int)foglia, (int)sotto);
+    for (int i = 0; i < 4; i++) r[i] = (unsigned int)q[i];
+#elif defined(PSICRO_CPUID_GCC)
+    if (!__get_cpuid_count(foglia, sotto, &r[0], &r[1], &r[2], &r[3])) r[0] = r[1] = r[2] = r[3] = 0;
+#else
+    (void)foglia; (void)sotto;
+    r[0] = r[1] = r[2] = r[3] = 0;
+#endif
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_cpu_caratteristiche(void) {
+    unsigned int r[4];
+    int c = 0;
+    cpuid(0, 0, r);
+    const unsigned int max_foglia = r[0];
+    if (max_foglia >= 1) {
+        cpuid(1, 0, r);
+        if (r[3] & (1u << 26)) c |= PSICRO_CPU_SSE2;
+        if (r[2] & (1u << 12)) c |= PSICRO_CPU_FMA;
+    }
+    if (max_foglia >= 7) {
+        cpuid(7, 0, r);
+        if (r[1] & (1u << 5)) c |= PSICRO_CPU_AVX2;
+        if (r[1] & (1u << 16)) c |= PSICRO_CPU_AVX512F;
+    }
+    return c;
+}
+
+// "<caratteristiche> <core> <modello>", modello senza spazi ("-" se ignoto)
+static void impronta(char* buf, size_t len) {
+    char modello[49];
+    unsigned int r[4];
+    memset(modello, 0, sizeof(modello));
+    cpuid(0x80000000u, 0, r);
+    if (r[0] >= 0x80000004u) {
+        for (unsigned int f = 0; f < 3; f++) {
+            cpuid(0x80000002u + f, 0, r);
+            memcpy(modello + 16 * f, r, 16);
+        }
+    }
+    char* a = modello;
+    while (*a == ' ') a++;
+    for (char* c = a; *c; c++) if (*c == ' ' || *c == '\t') *c = '_';
+    snprintf(buf, len, "%d %d %s", psicro_cpu_caratteristiche(), psicro_numero_cpu(), *a ? a : "-");
+}
+
+// --- ESECUZIONE DI UN PERCORSO ---
+static void esegui(int variante, int target, int id1, const double* v1, int id2, const double* v2,
+    long long n, double patm, double* out) {
+    if (variante == PSICRO_VAR_SOLUTORE) {
+        psicro_batch_tx_blocco(target, id1, v1, id2, v2, n, patm, out);
+        return;
+    }
+    // Funzione scalare alla stessa pressione delle altre varianti: adattatore di
+    // psicro_dispatch.c, che come le esportate azzera lo stato a ogni riga
+    psicro_fn_p fn = (variante == PSICRO_VAR_SCALARE) ? psicro_funzione_p(target, id1, id2) : NULL;
+    if (fn == NULL) {
+        psicro_batch_blocco(target, id1, v1, id2, v2, n, patm, out);
+        return;
+    }
+    if (id1 < id2) for (long long i = 0; i < n; i++) out[i] = fn(v1[i], v2[i], patm);
+    else for (long long i = 0; i < n; i++) out[i] = fn(v2[i], v1[i], patm);
+}
+
+// --- MISURA ---
+// Stati di bordo (t, ur): aria secca e quasi secca (sentinelle di tr e dei
+// titoli nulli), saturazione esatta e entro le soglie, 0 °C / punto triplo,
+// campo sotto zero e caldo fino a vicino l'ebollizione
+static const double bordi[PSICRO_TAR_BORDI][2] = {
+    { 20.0, 0.0 }, { 20.0, 0.0005 }, { 20.0, 0.001 }, { -40.0, 0.5 },
+    { 20.0, 100.0 }, { 20.0, 99.999995 }, { 20.0, 99.99999 }, { -20.0, 100.0 },
+    { 0.0, 100.0 }, { 0.005, 50.0 }, { T_TRIPLO, 100.0 }, { 0.0, 0.0 },
+    { 50.0, 100.0 }, { 60.0, 100.0 }, { 80.0, 90.0 }, { 95.0, 100.0 },
+};
+
+// Stati di taratura: (t, ur) sparsi su -20..50 °C, 5..95 %, più gli stati di
+// bordo in coda; per ciascuno tutte le grandezze
+static void stati_taratura(double patm, double v[PSICRO_N_PROP][PSICRO_TAR_CAMPIONI]) {
+    const int n_int = PSICRO_TAR_CAMPIONI - PSICRO_TAR_BORDI;
+    for (int k = 0; k < PSICRO_TAR_CAMPIONI; k++) {
+        double t = -20.0 + 70.0 * ((k * 37) % n_int) / (n_int - 1.0);
+        double ur = 5.0 + 90.0 * ((k * 59) % n_int) / (n_int - 1.0);
+        if (k >= n_int) {
+            t = bordi[k - n_int][0];
+            ur = bordi[k - n_int][1];
+        }
+        const double ps = core_Psat(t);
+        const double x = core_x_t_ur(t, ur, patm);
+        for (int p = 0; p < PSICRO_N_PROP; p++) v[p][k] = core_target_t_x(p, t, x, ps, patm);
+        v[PSICRO_T][k] = t;
+        v[PSICRO_UR][k] = ur;
+    }
+}
+
+static double errore_scala(int target, const double* out, const double* rif, int n) {
+    double e = 0.0;
+    for (int k = 0; k < n; k++) {
+        if (isnan(out[k]) || isnan(rif[k])) {
+            if (isnan(out[k]) != isnan(rif[k])) return HUGE_VAL;
+            continue;
+        }
+        double d = fabs(out[k] - rif[k]) / scala[target];
+        if (!(d <= e)) e = d;
+    }
+    return e;
+}
+
+// Costo minimo di avvio di una regione parallela vuota [ns]
+static double costo_parallelo(void) {
+    double minimo = HUGE_VAL;
+    for (int r = 0; r < 20; r++) {
+        unsigned long long t0 = psicro_ora_ns();
+#pragma omp parallel
+        {
+            volatile int z = 0;
+            (void)z;
+        }
+        double d = (double)(psicro_ora_ns() - t0);
+        if (d < minimo) minimo = d;
+    }
+    return minimo;
+}
+
+static void misura(double errore_max, double patm, voce_taratura tab[PSICRO_N_PROP][PSICRO_N_PROP][PSICRO_N_PROP]) {
+    static double v[PSICRO_N_PROP][PSICRO_TAR_CAMPIONI];
+    double rif[PSICRO_TAR_CAMPIONI], out[PSICRO_TAR_CAMPIONI];
+    const int n = PSICRO_TAR_CAMPIONI;
+    const psicro_tolleranze* salva = psicro_prec_thread;
+    psicro_prec_thread = &psicro_profili[PSICRO_PREC_RIFERIMENTO];
+    stati_taratura(patm, v);
+    const double avvio = (psicro_numero_cpu() > 1) ? costo_parallelo() : 0.0;
+
+    for (int id1 = 0; id1 < PSICRO_N_PROP; id1++) {
+        for (int id2 = id1 + 1; id2 < PSICRO_N_PROP; id2++) {
+            for (int target = 0; target < PSICRO_N_PROP; target++) {
+                if (target == id1 || target == id2) continue;
+                psicro_prec_thread = &psicro_profili[PSICRO_PREC_RIFERIMENTO];
+                esegui(PSICRO_VAR_SCALARE, target, id1, v[id1], id2, v[id2], n, patm, rif);
+                voce_taratura m = { PSICRO_VAR_SCALARE, PSICRO_PREC_RIFERIMENTO, HUGE_VAL, 0 };
+                for (int var = PSICRO_VAR_SCALARE; var <= PSICRO_VAR_SOLUTORE; var++) {
+                    // Con t il solutore coincide con il nucleo
+                    if (var == PSICRO_VAR_SOLUTORE && id1 == PSICRO_T) continue;
+                    for (int prof = 0; prof < PSICRO_N_PREC; prof++) {
+                        psicro_prec_thread = &psicro_profili[prof];
+                        double ns = HUGE_VAL;
+                        // Due ripetizioni: la prima scalda cache e predittori
+                        for (int r = 0; r < 2; r++) {
+                            unsigned long long t0 = psicro_ora_ns();
+                            esegui(var, target, id1, v[id1], id2, v[id2], n, patm, out);
+                            double d = (double)(psicro_ora_ns() - t0) / n;
+                            if (d < ns) ns = d;
+                        }
+                        const int ammesso = (var == PSICRO_VAR_SCALARE && prof == PSICRO_PREC_RIFERIMENTO)
+                            || errore_scala(target, out, rif, n) <= errore_max;
+                        if (ammesso && ns < m.ns_riga) {
+                            m.variante = var;
+                            m.profilo = prof;
+                            m.ns_riga = ns;
+                        }
+                    }
+                }
+                // Seriale finché il lavoro non vale qualche avvio di regione parallela
+                if (psicro_numero_cpu() <= 1) m.soglia_par = LLONG_MAX;
+                else m.soglia_par = (long long)(4.0 * avvio / (m.ns_riga > 1.0 ? m.ns_riga : 1.0));
+                tab[target][id1][id2] = m;
+            }
+        }
+    }
+    psicro_prec_thread = salva;
+}
+
+// --- CACHE SU FILE ---
+// Chiave: formato, versione dei modelli del nucleo, impronta dell'host,
+// pressione di taratura ed errore_max; tutto deve combaciare
+static int leggi_cache(const char* file, const char* imp, double patm, double errore_max,
+    voce_taratura tab[PSICRO_N_PROP][PSICRO_N_PROP][PSICRO_N_PROP]) {
+    FILE* f = fopen(file, "r");
+    if (f == NULL) return 0;
+    char riga[256];
+    int versione = 0, modello = 0, voci = 0, ok = 1;
+    double p = -1.0, e = -1.0;
+    if (fscanf(f, "PSICRO_AUTOTARATURA %d\n", &versione) != 1 || versione != PSICRO_TAR_VERSIONE) ok = 0;
+    if (ok && (fscanf(f, "versione_modello %d\n", &modello) != 1 || modello != PSICRO_TAB_VERSIONE_MODELLO)) ok = 0;
+    if (ok && (!fgets(riga, sizeof(riga), f) || strncmp(riga, "impronta ", 9) != 0)) ok = 0;
+    if (ok) {
+        riga[strcspn(riga, "\r\n")] = '\0';
+        if (strcmp(riga + 9, imp) != 0) ok = 0;
+    }
+    if (ok && (fscanf(f, "patm %lf\n", &p) != 1 || p != patm)) ok = 0;
+    if (ok && (fscanf(f, "errore_max %lf\n", &e) != 1 || e != errore_max)) ok = 0;
+    while (ok) {
+        int target, id1, id2, var, prof;
+        double ns;
+        long long soglia;
+        int letti = fscanf(f, "%d %d %d %d %d %lf %lld\n", &target, &id1, &id2, &var, &prof, &ns, &soglia);
+        if (letti == EOF) break;
+        if (letti != 7 || target < 0 || target >= PSICRO_N_PROP || id1 < 0 || id2 <= id1 || id2 >= PSICRO_N_PROP
+            || target == id1 || target == id2 || var < PSICRO_VAR_SCALARE || var > PSICRO_VAR_SOLUTORE
+            || prof < 0 || prof >= PSICRO_N_PREC) {
+            ok = 0;
+            break;
+        }
+        voce_taratura m = { var, prof, ns, soglia };
+        tab[target][id1][id2] = m;
+        voci++;
+    }
+    fclose(f);
+    // 21 coppie x 5 target
+    return ok && voci == 105;
+}
+
+// Come psicro_tabelle_salva: nome temporaneo per processo, poi rinomina
+static void scrivi_cache(const char* file, const char* imp, double patm, double errore_max,
+    voce_taratura tab[PSICRO_N_PROP][PSICRO_N_PROP][PSICRO_N_PROP]) {
+    char tmp[1024];
+#ifdef _WIN32
+    snprintf(tmp, sizeof(tmp), "%s.tmp%lu", file, (unsigned long)GetCurrentProcessId());
+#else
+    snprintf(tmp, sizeof(tmp), "%s.tmp%ld", file, (long)getpid());
+#endif
+    FILE* f = fopen(tmp, "w");
+    if (f == NULL) return;
+    fprintf(f, "PSICRO_AUTOTARATURA %d\nversione_modello %d\nimpronta %s\npatm %.17g\nerrore_max %.17g\n",
+        PSICRO_TAR_VERSIONE, PSICRO_TAB_VERSIONE_MODELLO, imp, patm, errore_max);
+    for (int id1 = 0; id1 < PSICRO_N_PROP; id1++)
+        for (int id2 = id1 + 1; id2 < PSICRO_N_PROP; id2++)
+            for (int target = 0; target < PSICRO_N_PROP; target++) {
+                if (target == id1 || target == id2) continue;
+                const voce_taratura* m = &tab[target][id1][id2];
+                fprintf(f, "%d %d %d %d %d %.1f %lld\n", target, id1, id2, m->variante, m->profilo, m->ns_riga, m->soglia_par);
+            }
+    if (fclose(f) != 0) {
+        remove(tmp);
+        return;
+    }
+#ifdef _WIN32
+    if (!MoveFileExA(tmp, file, MOVEFILE_REPLACE_EXISTING)) remove(tmp);
+#else
+    if (rename(tmp, file) != 0) remove(tmp);
+#endif
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_autotaratura(double errore_max, const char* file_cache, int forza) {
+    if (!(errore_max >= 0.0)) return PSICRO_ERR_ARG;
+    static voce_taratura tab[PSICRO_N_PROP][PSICRO_N_PROP][PSICRO_N_PROP];
+    char imp[128];
+    impronta(imp, sizeof(imp));
+    // Una taratura alla volta; le letture di psicro_batch_auto vedono la tabella precedente
+    static psicro_mutex mtx_misura = PSICRO_MUTEX_INIT;
+    psicro_mutex_lock(&mtx_misura);
+    const double patm = PATM;
+    int da_cache = (!forza && file_cache && leggi_cache(file_cache, imp, patm, errore_max, tab));
+    if (!da_cache) {
+        misura(errore_max, patm, tab);
+        if (file_cache) scrivi_cache(file_cache, imp, patm, errore_max, tab);
+    }
+    psicro_mutex_lock(&mtx_taratura);
+    memcpy(scelte, tab, sizeof(scelte));
+    tarata = 1;
+    psicro_mutex_unlock(&mtx_taratura);
+    psicro_mutex_unlock(&mtx_misura);
+    return da_cache;
+}
+
+// --- USO DELLA TABELLA ---
+static voce_taratura voce(int target, int id1, int id2) {
+    voce_taratura m = { PSICRO_VAR_NUCLEO, -1, 0.0, 0 };   // Come psicro_batch
+    if (id1 > id2) {
+        int tmp = id1;
+        id1 = id2;
+        id2 = tmp;
+    }
+    if (target == id1 || target == id2) return m;
+    psicro_mutex_lock(&mtx_taratura);
+    if (tarata) m = scelte[target][id1][id2];
+    psicro_mutex_unlock(&mtx_taratura);
+    return m;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_autotaratura_scelta(int target, int id1, int id2,
+    int* variante, int* profilo, double* ns_riga, long long* soglia_par) {
+    if (id1 == id2) return PSICRO_ERR_ARG;
+    if (id1 < 0 || id1 >= PSICRO_N_PROP || id2 < 0 || id2 >= PSICRO_N_PROP || target < 0 || target >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+    voce_taratura m = voce(target, id1, id2);
+    if (variante) *variante = m.variante;
+    if (profilo) *profilo = m.profilo;
+    if (ns_riga) *ns_riga = m.ns_riga;
+    if (soglia_par) *soglia_par = m.soglia_par;
+    return PSICRO_OK;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_batch_auto(int target, int id1, const double* v1, int id2, const double* v2,
+    long long n, double* out) {
+    if (!v1 || !v2 || !out || n <= 0 || id1 == id2) return PSICRO_ERR_ARG;
+    if (id1 < 0 || id1 >= PSICRO_N_PROP || id2 < 0 || id2 >= PSICRO_N_PROP || target < 0 || target >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+    const voce_taratura m = voce(target, id1, id2);
+    const psicro_tolleranze* prof = (m.profilo < 0) ? NULL : &psicro_profili[m.profilo];
+    const double p = PATM;
+    if (n < m.soglia_par) {
+        const psicro_tolleranze* salva = psicro_prec_thread;
+        if (prof) psicro_prec_thread = prof;
+        esegui(m.variante, target, id1, v1, id2, v2, n, p, out);
+        psicro_prec_thread = salva;
+        return PSICRO_OK;
+    }
+    const long long blocco = 4096;
+    const long long n_blocchi = (n + blocco - 1) / blocco;
+#pragma omp parallel
+    {
+        // Il profilo vive nel TLS: lo imposta ogni thread del team
+        const psicro_tolleranze* salva = psicro_prec_thread;
+        if (prof) psicro_prec_thread = prof;
+#pragma omp for schedule(dynamic)
+        for (long long b = 0; b < n_blocchi; b++) {
+            long long i0 = b * blocco;
+            long long mb = (i0 + blocco < n) ? blocco : n - i0;
+            esegui(m.variante, target, id1, v1 + i0, id2, v2 + i0, mb, p, out + i0);
+        }
+        psicro_prec_thread = salva;
+    }
+    return PSICRO_OK;
+}
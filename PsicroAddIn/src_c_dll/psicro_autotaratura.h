@@ -0,0 +1,57 @@
+#ifndef PSICRO_AUTOTARATURA_H
+#define PSICRO_AUTOTARATURA_H
+
+#include "psicrometria.h"
+
+// --- AUTOTARATURA DEI PERCORSI DI CALCOLO SULL'HOST ---
+// Per ogni funzione (target, coppia) esistono più modi di calcolo: la funzione
+// scalare della tabella, il nucleo senza stato di psicro_batch (stesse funzioni
+// scalari) o il solutore generico (t, x) per le coppie senza t, ciascuno con i
+// tre profili di precisione, tutti alla stessa pressione. psicro_autotaratura
+// misura tutte le combinazioni su un insieme di stati di taratura (campo
+// tipico più stati di bordo: aria secca, saturazione, 0 °C, caldo), scarta
+// quelle con errore oltre errore_max rispetto alla funzione scalare con il
+// profilo di riferimento e sceglie la più veloce. Il limite vale sugli stati
+// di taratura, non è una garanzia per ogni ingresso.
+// Misura anche il costo di avvio di una regione parallela: sotto una soglia
+// di righe, dipendente dal costo per riga, psicro_batch_auto resta seriale.
+//
+// La tabella scelta si salva in un piccolo file di testo insieme alla
+// versione dei modelli del nucleo (PSICRO_TAB_VERSIONE_MODELLO), all'impronta
+// dell'host (caratteristiche della CPU, numero di core), alla PATM di taratura
+// e a errore_max: un processo successivo con la stessa chiave la rilegge senza
+// misurare. Il file si scrive su un nome temporaneo rinominato alla fine.
+// Senza taratura psicro_batch_auto equivale a psicro_batch.
+#define PSICRO_VAR_SCALARE        0   // Funzione della tabella, stato azzerato a ogni riga
+#define PSICRO_VAR_NUCLEO         1   // Nucleo a pressione esplicita (come psicro_batch)
+#define PSICRO_VAR_SOLUTORE       2   // Solutore (t, x) (come psicro_batch_tx)
+#define PSICRO_TAR_CAMPIONI       144 // Stati di taratura per funzione, bordi compresi
+#define PSICRO_TAR_BORDI          16  // Di cui stati di bordo
+#define PSICRO_TAR_VERSIONE       3   // Formato del file di cache
+
+// Caratteristiche della CPU (psicro_cpu_caratteristiche)
+#define PSICRO_CPU_SSE2           1
+#define PSICRO_CPU_AVX2           2
+#define PSICRO_CPU_AVX512F        4
+#define PSICRO_CPU_FMA            8
+
+// Maschera PSICRO_CPU_* dell'host (0 su architetture non x86)
+PSICRO_EXPORT int PSICRO_CALL psicro_cpu_caratteristiche(void);
+
+// errore_max: errore ammesso in unità di scala della grandezza (1 K, 1 %,
+//             1 g/kg, 1 kJ/kg, 1 L/kg) sugli stati di taratura, es. 1e-6; 0 = solo
+//             percorsi identici al riferimento su quegli stati
+// file_cache: (opz.) percorso del file; se valido per questo host, per la PATM
+//             corrente e per errore_max si legge, altrimenti si misura e si riscrive
+// forza:      1 = misura comunque
+// Ritorna 1 se la tabella viene dalla cache, 0 se misurata, o un PSICRO_ERR_*
+PSICRO_EXPORT int PSICRO_CALL psicro_autotaratura(double errore_max, const char* file_cache, int forza);
+// Scelta corrente per (target, id1, id2); variante, profilo (-1 = di processo),
+// ns_riga e soglia_par (righe sotto cui si resta seriali) sono opzionali
+PSICRO_EXPORT int PSICRO_CALL psicro_autotaratura_scelta(int target, int id1, int id2,
+	int* variante, int* profilo, double* ns_riga, long long* soglia_par);
+// Come psicro_batch con il percorso scelto dalla taratura
+PSICRO_EXPORT int PSICRO_CALL psicro_batch_auto(int target, int id1, const double* v1, int id2, const double* v2,
+	long long n, double* out);
+
+#endif
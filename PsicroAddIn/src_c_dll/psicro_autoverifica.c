@@ -0,0 +1,89 @@
+#include "psicro_autoverifica.h"
+#include "psicro_precisione.h"
+#include "psicro_thread.h"
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// --- INGRESSI PATOLOGICI ---
+// Valori validi per qualche grandezza e patologici per altre: ogni coppia
+// (v1, v2) si prova su tutte le funzioni. NaN e infiniti si aggiungono in
+// psicro_autoverifica (NAN e INFINITY non sono costanti per tutti i compilatori).
+static const double speciali[] = {
+    0.0, -0.0, 1e-300, -1e-300, 4.9e-324, DBL_MIN, DBL_MAX, -DBL_MAX, 1e300, -1e300,
+    1e-6, 0.001, 0.01, 0.05, 0.5, 1.0, -0.01,                // titoli, ur piccole
+    -273.15, -300.0, -110.0, -100.0, -40.0, -5.0, -1e-9, 1e-9, 0.01, 4.0, // a cavallo di 0 °C
+    20.0, 35.0, 60.0, 99.99999, 100.0, 100.00001, 150.0, 180.0, 374.0, 1000.0, 1e6,
+    -1000.0, 0.7, 0.85, 0.95, 2.0, 10.0,                       // entalpie e volumi
+};
+#define N_FINITI    ((int)(sizeof(speciali) / sizeof(speciali[0])))
+#define N_SPECIALI  (N_FINITI + 3)
+
+// splitmix64 come in psicro_incertezza.c
+static uint64_t mescola(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+// Valore con segno e ordine di grandezza casuali (1e-8 .. 1e8), a volte un valore speciale
+static double casuale(const double* valori, uint64_t seme, uint64_t k) {
+    uint64_t r = mescola(seme + k * 0x9E3779B97F4A7C15ull);
+    if ((r & 15) == 0) return valori[(r >> 4) % N_SPECIALI];
+    double u = (double)(r >> 11) * (1.0 / 9007199254740992.0);
+    double v = pow(10.0, -8.0 + 16.0 * u);
+    return ((r >> 4) & 1) ? -v : v;
+}
+
+static void prova(psicro_fn fn, int target, int id1, int id2, double v1, double v2, psicro_autoverifica_out* out) {
+    unsigned long long t0 = psicro_ora_ns();
+    volatile double r = fn(v1, v2);
+    double ns = (double)(psicro_ora_ns() - t0);
+    (void)r;
+    int stato = psicro_stato();
+    int val = psicro_valutazioni();
+    out->chiamate++;
+    if (stato & PSICRO_STATO_NON_CONV) out->non_conv++;
+    if (stato & PSICRO_STATO_NO_SOL) out->no_sol++;
+    if (val > PSICRO_BUDGET_CHIAMATA) out->fuori_budget++;
+    if (ns > out->max_ns) out->max_ns = ns;
+    if (val > out->max_valutazioni) {
+        out->max_valutazioni = val;
+        out->caso_target = target;
+        out->caso_id1 = id1;
+        out->caso_id2 = id2;
+        out->caso_v1 = v1;
+        out->caso_v2 = v2;
+    }
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_autoverifica(long long n_casuali, unsigned long long seme,
+    psicro_autoverifica_out* out) {
+    if (!out) return PSICRO_ERR_ARG;
+    memset(out, 0, sizeof(*out));
+    out->caso_target = out->caso_id1 = out->caso_id2 = -1;
+    double valori[N_SPECIALI];
+    memcpy(valori, speciali, sizeof(speciali));
+    valori[N_FINITI] = NAN;
+    valori[N_FINITI + 1] = HUGE_VAL;
+    valori[N_FINITI + 2] = -HUGE_VAL;
+    for (int target = 0; target < PSICRO_N_PROP; target++) {
+        for (int id1 = 0; id1 < PSICRO_N_PROP; id1++) {
+            for (int id2 = id1 + 1; id2 < PSICRO_N_PROP; id2++) {
+                if (target == id1 || target == id2) continue;
+                psicro_fn fn = psicro_funzione(target, id1, id2);
+                if (fn == NULL) continue;
+                for (int a = 0; a < N_SPECIALI; a++) {
+                    for (int b = 0; b < N_SPECIALI; b++) prova(fn, target, id1, id2, valori[a], valori[b], out);
+                }
+                uint64_t chiave = seme ^ ((uint64_t)(target * 64 + id1 * 8 + id2) << 40);
+                for (long long k = 0; k < n_casuali; k++) {
+                    double v1 = casuale(valori, chiave, 2 * (uint64_t)k);
+                    double v2 = casuale(valori, chiave, 2 * (uint64_t)k + 1);
+                    prova(fn, target, id1, id2, v1, v2, out);
+                }
+            }
+        }
+    }
+    return (out->fuori_budget > 0) ? (int)(out->fuori_budget < 0x7fffffff ? out->fuori_budget : 0x7fffffff) : PSICRO_OK;
+}
@@ -0,0 +1,32 @@
+#ifndef PSICRO_AUTOVERIFICA_H
+#define PSICRO_AUTOVERIFICA_H
+
+#include "psicrometria.h"
+
+// --- AUTOVERIFICA DEI LIMITI DI LATENZA ---
+// Chiama tutte le 105 funzioni (target, coppia) su un insieme di ingressi
+// patologici (NaN, infiniti, zeri con segno, subnormali, valori enormi, ur
+// oltre 100 o negativa, titolo negativo, temperature sotto lo zero assoluto,
+// valori a cavallo di 0 °C) in tutte le combinazioni, più n_casuali coppie
+// pseudo-casuali su scala logaritmica. Per ogni chiamata legge psicro_stato()
+// e psicro_valutazioni() e misura la durata: il risultato dice se qualche
+// ingresso supera il budget di valutazioni PSICRO_BUDGET_CHIAMATA.
+// Va eseguita al caricamento o dopo una modifica dei solutori; è seriale.
+
+typedef struct {
+	long long chiamate;          // Chiamate eseguite
+	long long non_conv;          // ... terminate con PSICRO_STATO_NON_CONV
+	long long no_sol;            // ... terminate con PSICRO_STATO_NO_SOL
+	long long fuori_budget;      // ... con più di PSICRO_BUDGET_CHIAMATA valutazioni
+	int max_valutazioni;         // Valutazioni massime in una chiamata
+	double max_ns;               // Durata massima di una chiamata [ns] (con le interruzioni del SO)
+	int caso_target, caso_id1, caso_id2;   // Chiamata con più valutazioni
+	double caso_v1, caso_v2;
+} psicro_autoverifica_out;
+
+// Ritorna PSICRO_OK se nessuna chiamata supera il budget, altrimenti il numero
+// (positivo) di chiamate fuori budget; PSICRO_ERR_ARG con out NULL.
+PSICRO_EXPORT int PSICRO_CALL psicro_autoverifica(long long n_casuali, unsigned long long seme,
+	psicro_autoverifica_out* out);
+
+#endif
@@ -0,0 +1,109 @@
+// Le funzioni batch non espongono stato né valutazioni (psicro_batch_stato usa
+// gli adattatori di psicro_dispatch.c): il nucleo si compila senza conteggio e
+// i cicli non toccano il TLS del contesto.
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicrometria.h"
+#include "psicro_core.h"
+#include "psicro_tabella.h"
+#include <stddef.h>
+
+// --- ADATTATORI DEL NUCLEO ---
+// Come quelli di psicro_dispatch.c, senza azzerare il contesto del thread
+typedef struct {
+    int target, id1, id2;
+    psicro_fn_p fn;
+} voce_nucleo;
+
+#define NUCLEO_P(nome) static double nome##_p(double a, double b, double patm) { \
+    return core_##nome(a, b, patm); }
+#define NUCLEO(nome) static double nome##_p(double a, double b, double patm) { \
+    (void)patm; return core_##nome(a, b); }
+#define ADATTATORE(target, id1, id2, nome, nucleo) nucleo(nome)
+PSICRO_TABELLA(ADATTATORE)
+
+#define RIGA(target, id1, id2, nome, nucleo) { target, id1, id2, nome##_p },
+static const voce_nucleo tabella[] = {
+    PSICRO_TABELLA(RIGA)
+};
+
+static psicro_fn_p funzione_nucleo(int target, int id1, int id2) {
+    if (id1 > id2) {
+        int tmp = id1;
+        id1 = id2;
+        id2 = tmp;
+    }
+    for (size_t i = 0; i < sizeof(tabella) / sizeof(tabella[0]); i++) {
+        if (tabella[i].target == target && tabella[i].id1 == id1 && tabella[i].id2 == id2) return tabella[i].fn;
+    }
+    return NULL;
+}
+
+// --- VALUTAZIONE BATCH ---
+// Blocco seriale a pressione esplicita: ogni coppia, t compresa, passa per gli
+// adattatori delle funzioni scalari, sentinelle incluse. Con patm = PATM il
+// risultato coincide bit a bit con psicro_calc riga per riga.
+void psicro_batch_blocco(int target, int id1, const double* v1, int id2, const double* v2,
+    long long n, double patm, double* out) {
+    if (target == id1 || target == id2) {
+        const double* v = (target == id1) ? v1 : v2;
+        for (long long i = 0; i < n; i++) out[i] = v[i];
+        return;
+    }
+    psicro_fn_p fn = funzione_nucleo(target, id1, id2);
+    if (fn == NULL) {
+        for (long long i = 0; i < n; i++) out[i] = NAN;
+        return;
+    }
+    if (id1 < id2) for (long long i = 0; i < n; i++) out[i] = fn(v1[i], v2[i], patm);
+    else for (long long i = 0; i < n; i++) out[i] = fn(v2[i], v1[i], patm);
+}
+
+// Come psicro_batch_blocco, con le coppie senza t risolte da core_stato_tx
+void psicro_batch_tx_blocco(int target, int id1, const double* v1, int id2, const double* v2,
+    long long n, double patm, double* out) {
+    if (id1 == PSICRO_T || id2 == PSICRO_T) {
+        psicro_batch_blocco(target, id1, v1, id2, v2, n, patm, out);
+        return;
+    }
+    for (long long i = 0; i < n; i++) {
+        if (target == id1 || target == id2) {
+            out[i] = (target == id1) ? v1[i] : v2[i];
+            continue;
+        }
+        double t, x;
+        if (core_stato_tx(id1, v1[i], id2, v2[i], patm, &t, &x) != PSICRO_OK) out[i] = NAN;
+        else out[i] = core_target_t_x(target, t, x, core_Psat(t), patm);
+    }
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_batch(int target, int id1, const double* v1, int id2, const double* v2,
+    long long n, double* out) {
+    if (!v1 || !v2 || !out || n <= 0 || id1 == id2) return PSICRO_ERR_ARG;
+    if (id1 < 0 || id1 >= PSICRO_N_PROP || id2 < 0 || id2 >= PSICRO_N_PROP || target < 0 || target >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+    const double p = PATM;
+    const long long blocco = 4096;
+    const long long n_blocchi = (n + blocco - 1) / blocco;
+#pragma omp parallel for schedule(dynamic)
+    for (long long b = 0; b < n_blocchi; b++) {
+        long long i0 = b * blocco;
+        long long m = (i0 + blocco < n) ? blocco : n - i0;
+        psicro_batch_blocco(target, id1, v1 + i0, id2, v2 + i0, m, p, out + i0);
+    }
+    return PSICRO_OK;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_batch_tx(int target, int id1, const double* v1, int id2, const double* v2,
+    long long n, double* out) {
+    if (!v1 || !v2 || !out || n <= 0 || id1 == id2) return PSICRO_ERR_ARG;
+    if (id1 < 0 || id1 >= PSICRO_N_PROP || id2 < 0 || id2 >= PSICRO_N_PROP || target < 0 || target >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+    const double p = PATM;
+    const long long blocco = 4096;
+    const long long n_blocchi = (n + blocco - 1) / blocco;
+#pragma omp parallel for schedule(dynamic)
+    for (long long b = 0; b < n_blocchi; b++) {
+        long long i0 = b * blocco;
+        long long m = (i0 + blocco < n) ? blocco : n - i0;
+        psicro_batch_tx_blocco(target, id1, v1 + i0, id2, v2 + i0, m, p, out + i0);
+    }
+    return PSICRO_OK;
+}
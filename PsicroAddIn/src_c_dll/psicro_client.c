@@ -0,0 +1,171 @@
+#ifndef _WIN32
+#include "psicro_service.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+struct psicro_client {
+    int fd;
+    int n_slot, righe_slot;
+    char* base;
+    size_t dim;
+    char shm[64];
+};
+
+static int invia_tutto(int fd, const void* buf, size_t n) {
+    const char* p = (const char*)buf;
+    while (n > 0) {
+        ssize_t k = send(fd, p, n, MSG_NOSIGNAL);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return -1;
+        p += k;
+        n -= (size_t)k;
+    }
+    return 0;
+}
+static int ricevi_tutto(int fd, void* buf, size_t n) {
+    char* p = (char*)buf;
+    while (n > 0) {
+        ssize_t k = recv(fd, p, n, 0);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return -1;
+        p += k;
+        n -= (size_t)k;
+    }
+    return 0;
+}
+
+PSICRO_EXPORT psicro_client* PSICRO_CALL psicro_client_apri(const char* socket_path, int n_slot, int righe_slot) {
+    if (socket_path == NULL) socket_path = PSICRO_SVC_SOCKET;
+    if (n_slot <= 0 || n_slot > PSICRO_SVC_MAX_SLOT || righe_slot <= 0) return NULL;
+    psicro_client* c = (psicro_client*)calloc(1, sizeof(psicro_client));
+    if (c == NULL) return NULL;
+    c->fd = -1;
+    c->n_slot = n_slot;
+    c->righe_slot = righe_slot;
+    c->dim = PSICRO_SVC_SLOT_BYTE(righe_slot) * (size_t)n_slot;
+
+    // 1. Regione condivisa creata dal client
+    snprintf(c->shm, sizeof(c->shm), "%s-%ld-%p", PSICRO_SVC_SHM, (long)getpid(), (void*)c);
+    int shm_fd = shm_open(c->shm, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (shm_fd < 0) goto errore;
+    if (ftruncate(shm_fd, (off_t)c->dim) != 0) {
+        close(shm_fd);
+        goto errore;
+    }
+    c->base = (char*)mmap(NULL, c->dim, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    close(shm_fd);
+    if (c->base == MAP_FAILED) {
+        c->base = NULL;
+        goto errore;
+    }
+
+    // 2. Connessione e presentazione
+    struct sockaddr_un ind;
+    memset(&ind, 0, sizeof(ind));
+    ind.sun_family = AF_UNIX;
+    strncpy(ind.sun_path, socket_path, sizeof(ind.sun_path) - 1);
+    c->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (c->fd < 0 || connect(c->fd, (struct sockaddr*)&ind, sizeof(ind)) != 0) goto errore;
+    psicro_svc_hello hello;
+    memset(&hello, 0, sizeof(hello));
+    hello.magic = PSICRO_SVC_MAGIC;
+    hello.versione = PSICRO_SVC_VERSIONE;
+    hello.n_slot = (uint32_t)n_slot;
+    hello.righe_slot = (uint32_t)righe_slot;
+    snprintf(hello.shm, sizeof(hello.shm), "%s", c->shm);
+    int32_t ok;
+    if (invia_tutto(c->fd, &hello, sizeof(hello)) != 0 || ricevi_tutto(c->fd, &ok, sizeof(ok)) != 0 || ok != PSICRO_OK) goto errore;
+    // Il server ha mappato la regione: il nome non serve più
+    shm_unlink(c->shm);
+    c->shm[0] = '\0';
+    return c;
+
+errore:
+    psicro_client_chiudi(c);
+    return NULL;
+}
+
+PSICRO_EXPORT void PSICRO_CALL psicro_client_chiudi(psicro_client* c) {
+    if (c == NULL) return;
+    if (c->fd >= 0) close(c->fd);
+    if (c->base) munmap(c->base, c->dim);
+    if (c->shm[0]) shm_unlink(c->shm);
+    free(c);
+}
+
+PSICRO_EXPORT double* PSICRO_CALL psicro_client_v1(psicro_client* c, int slot) {
+    return (double*)(c->base + PSICRO_SVC_SLOT_BYTE(c->righe_slot) * (size_t)slot);
+}
+PSICRO_EXPORT double* PSICRO_CALL psicro_client_v2(psicro_client* c, int slot) { return psicro_client_v1(c, slot) + c->righe_slot; }
+PSICRO_EXPORT double* PSICRO_CALL psicro_client_out(psicro_client* c, int slot) { return psicro_client_v1(c, slot) + 2 * (size_t)c->righe_slot; }
+
+PSICRO_EXPORT int PSICRO_CALL psicro_client_invia(psicro_client* c, int slot, int target, int id1, int id2, long long n, double patm) {
+    if (c == NULL || slot < 0 || slot >= c->n_slot || n <= 0 || n > c->righe_slot) return PSICRO_ERR_ARG;
+    psicro_svc_req q;
+    memset(&q, 0, sizeof(q));
+    q.slot = (uint32_t)slot;
+    q.target = target;
+    q.id1 = id1;
+    q.id2 = id2;
+    q.n = n;
+    q.patm = patm;
+    return (invia_tutto(c->fd, &q, sizeof(q)) == 0) ? PSICRO_OK : PSICRO_ERR_ARG;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_client_ricevi(psicro_client* c, int* slot) {
+    psicro_svc_resp r;
+    if (c == NULL || ricevi_tutto(c->fd, &r, sizeof(r)) != 0) return PSICRO_ERR_ARG;
+    if (slot) *slot = (int)r.slot;
+    return r.stato;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_client_batch(psicro_client* c, int target, int id1, const double* v1, int id2, const double* v2,
+    long long n, double patm, double* out) {
+    if (c == NULL || !v1 || !v2 || !out || n <= 0) return PSICRO_ERR_ARG;
+    long long inizio_slot[PSICRO_SVC_MAX_SLOT];
+    long long prossimo = 0;
+    int in_volo = 0, stato = PSICRO_OK;
+    // Riempie tutti gli slot, poi ne rimette in volo uno per ogni risposta
+    for (int s = 0; s < c->n_slot && prossimo < n; s++) {
+        long long m = (prossimo + c->righe_slot < n) ? c->righe_slot : n - prossimo;
+        memcpy(psicro_client_v1(c, s), v1 + prossimo, (size_t)m * sizeof(double));
+        memcpy(psicro_client_v2(c, s), v2 + prossimo, (size_t)m * sizeof(double));
+        if (psicro_client_invia(c, s, target, id1, id2, m, patm) != PSICRO_OK) return PSICRO_ERR_ARG;
+        inizio_slot[s] = prossimo;
+        prossimo += m;
+        in_volo++;
+    }
+    while (in_volo > 0) {
+        int s = -1;
+        int r = psicro_client_ricevi(c, &s);
+        if (s < 0 || s >= c->n_slot) return PSICRO_ERR_ARG;
+        in_volo--;
+        if (r != PSICRO_OK) {
+            stato = r;
+        }
+        else {
+            long long i0 = inizio_slot[s];
+            long long m = (i0 + c->righe_slot < n) ? c->righe_slot : n - i0;
+            memcpy(out + i0, psicro_client_out(c, s), (size_t)m * sizeof(double));
+        }
+        if (stato == PSICRO_OK && prossimo < n) {
+            long long m = (prossimo + c->righe_slot < n) ? c->righe_slot : n - prossimo;
+            memcpy(psicro_client_v1(c, s), v1 + prossimo, (size_t)m * sizeof(double));
+            memcpy(psicro_client_v2(c, s), v2 + prossimo, (size_t)m * sizeof(double));
+            if (psicro_client_invia(c, s, target, id1, id2, m, patm) != PSICRO_OK) return PSICRO_ERR_ARG;
+            inizio_slot[s] = prossimo;
+            prossimo += m;
+            in_volo++;
+        }
+    }
+    return stato;
+}
+
+#endif
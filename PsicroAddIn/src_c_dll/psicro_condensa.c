@@ -0,0 +1,64 @@
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicro_condensa.h"
+#include "psicro_core.h"
+#include <stdlib.h>
+
+// Temperature limite di una zona-ora dalla pressione di vapore dell'aria
+static void limiti_zona(int id2, double t, double v2, double soglia, double patm, double* t_rug, double* t_muffa) {
+    core_termini_t k;
+    core_termini(id2, t, v2, &k);
+    double x = core_x_coppia_t(id2, t, v2, &k, patm);
+    if (!(x > 0.0)) {
+        // Aria secca (o stato non valido): nessun rischio
+        *t_rug = *t_muffa = -273.15;
+        return;
+    }
+    double pv = (x * patm) / (RAV + x);
+    if (pv >= k.ps_t) pv = k.ps_t; // Saturazione: la rugiada coincide con t
+    *t_rug = core_TPsat(pv);
+    // ur_sup = pv / Psat(t_sup) >= soglia  <=>  t_sup <= TPsat(pv / soglia)
+    *t_muffa = core_TPsat(pv / soglia);
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_rischio_condensa(int id2, const double* t_aria, const double* v2, int n_zone,
+    const double* t_sup, const int* zona, long long n_nodi, int n_ore, double soglia_muffa,
+    double* margine, unsigned char* maschera, int* ore_condensa, int* ore_muffa) {
+    if (!t_aria || !v2 || !t_sup || !zona || n_zone <= 0 || n_nodi <= 0 || n_ore <= 0) return PSICRO_ERR_ARG;
+    if (id2 < PSICRO_UR || id2 > PSICRO_TR) return PSICRO_ERR_NON_SUPP;
+    for (long long i = 0; i < n_nodi; i++) {
+        if (zona[i] < 0 || zona[i] >= n_zone) return PSICRO_ERR_ARG;
+    }
+    const double soglia = ((soglia_muffa > 0.0) ? soglia_muffa : 80.0) / 100.0;
+    const double patm = PATM;
+    const long long n_zo = (long long)n_ore * n_zone;
+    double* t_rug = (double*)malloc((size_t)n_zo * 2 * sizeof(double));
+    if (t_rug == NULL) return PSICRO_ERR_MEM;
+    double* t_muffa = t_rug + n_zo;
+
+    // 1. Una coppia di inversioni per zona-ora
+#pragma omp parallel for schedule(static)
+    for (long long j = 0; j < n_zo; j++) {
+        limiti_zona(id2, t_aria[j], v2[j], soglia, patm, &t_rug[j], &t_muffa[j]);
+    }
+
+    // 2. Confronto sui nodi, ora per ora
+    for (int o = 0; o < n_ore; o++) {
+        const double* ts = t_sup + (long long)o * n_nodi;
+        const double* rug = t_rug + (long long)o * n_zone;
+        const double* muf = t_muffa + (long long)o * n_zone;
+        double* mg = margine ? margine + (long long)o * n_nodi : NULL;
+        unsigned char* mk = maschera ? maschera + (long long)o * n_nodi : NULL;
+#pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n_nodi; i++) {
+            const int z = zona[i];
+            const int c = (ts[i] <= rug[z]);
+            const int m = (ts[i] <= muf[z]);
+            if (mg) mg[i] = ts[i] - rug[z];
+            if (mk) mk[i] = (unsigned char)(c * PSICRO_RISCHIO_CONDENSA | m * PSICRO_RISCHIO_MUFFA);
+            if (ore_condensa) ore_condensa[i] += c;
+            if (ore_muffa) ore_muffa[i] += m;
+        }
+    }
+    free(t_rug);
+    return PSICRO_OK;
+}
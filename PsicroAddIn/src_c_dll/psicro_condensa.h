@@ -0,0 +1,30 @@
+#ifndef PSICRO_CONDENSA_H
+#define PSICRO_CONDENSA_H
+
+#include "psicrometria.h"
+
+// --- RISCHIO DI CONDENSA E MUFFA SU CAMPI DI TEMPERATURA SUPERFICIALE ---
+// Lo stato dell'aria è per zona e per ora; le temperature superficiali sono per
+// nodo (es. mesh FE) e ogni nodo appartiene a una zona. Per ogni zona-ora si
+// calcolano una volta la temperatura di rugiada e la temperatura superficiale
+// critica per la muffa (ur superficiale = soglia_muffa, EN ISO 13788); il ciclo
+// sui nodi è solo un confronto, vettorizzabile e parallelo.
+//
+// Le ore si possono passare una alla volta o a blocchi: ore_condensa e
+// ore_muffa sono accumulatori (si incrementano, non si azzerano).
+#define PSICRO_RISCHIO_CONDENSA  1   // t_sup <= t_rugiada
+#define PSICRO_RISCHIO_MUFFA     2   // ur alla superficie >= soglia_muffa
+
+// id2:          grandezza nota insieme a t per l'aria (PSICRO_UR, PSICRO_X, PSICRO_TR ...)
+// t_aria, v2:   n_ore * n_zone valori, disposti [ora][zona]
+// t_sup:        n_ore * n_nodi temperature superficiali [°C], disposte [ora][nodo]
+// zona:         n_nodi indici di zona (0 .. n_zone-1)
+// soglia_muffa: ur superficiale critica [%] (<= 0 -> 80)
+// margine:      (opz.) n_ore * n_nodi valori t_sup - t_rugiada [K]
+// maschera:     (opz.) n_ore * n_nodi flag PSICRO_RISCHIO_*
+// ore_condensa, ore_muffa: (opz.) n_nodi contatori di ore a rischio
+PSICRO_EXPORT int PSICRO_CALL psicro_rischio_condensa(int id2, const double* t_aria, const double* v2, int n_zone,
+	const double* t_sup, const int* zona, long long n_nodi, int n_ore, double soglia_muffa,
+	double* margine, unsigned char* maschera, int* ore_condensa, int* ore_muffa);
+
+#endif
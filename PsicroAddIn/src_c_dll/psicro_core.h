@@ -0,0 +1,1201 @@
+#ifndef PSICRO_CORE_H
+#define PSICRO_CORE_H
+
+// Nucleo interno della libreria: funzioni inline con pressione esplicita.
+// Le funzioni esportate (PSICRO_API) leggono PATM e delegano a queste; i motori
+// batch le usano direttamente per gestire una pressione diversa per ogni riga
+// senza toccare la variabile globale.
+
+#include <math.h>
+#include "psicrometria.h"
+#include "psicro_precisione.h"
+
+// --- PRESSIONE ATMOSFERICA ---
+PSICRO_INLINE double core_patm_quota(double altitude) {
+    // Patm = 101325 * (1 - 2.25577 * 10^-5 * Quota) ^ 5.2559
+    return 101.325 * pow(1.0 - 2.25577e-5 * altitude, 5.2559);
+}
+
+// --- SATURAZIONE (Hyland-Wexler, ASHRAE Fundamentals) ---
+PSICRO_INLINE double core_Psat(double t) {
+    double T = t + 273.15;
+    double lnPs;
+    if (t >= T_TRIPLO) {
+        // Acqua liquida
+        const double C8 = -5800.2206;
+        const double C9 = 1.3914993;
+        const double C10 = -0.048640239;
+        const double C11 = 0.000041764768;
+        const double C12 = -0.000000014452093;
+        const double C13 = 6.5459673;
+        lnPs = (C8 / T) + C9 + (C10 * T) + (C11 * T * T) + (C12 * T * T * T) + (C13 * log(T));
+    }
+    else {
+        // Ghiaccio
+        const double C1 = -5674.5359;
+        const double C2 = 6.3925247;
+        const double C3 = -0.009677843;
+        const double C4 = 0.00000062215701;
+        const double C5 = 0.0000000020747825;
+        const double C6 = -0.0000000000009484024;
+        const double C7 = 4.1635019;
+        lnPs = (C1 / T) + C2 + (C3 * T) + (C4 * T * T) + (C5 * T * T * T) + (C6 * T * T * T * T) + (C7 * log(T));
+    }
+    return exp(lnPs) / 1000.0; // kPa
+}
+PSICRO_INLINE double core_dPsat_dt(double t) {
+    double T = t + 273.15;
+    double dlnPs;
+    if (t >= T_TRIPLO) {
+        const double C8 = -5800.2206;
+        const double C10 = -0.048640239;
+        const double C11 = 0.000041764768;
+        const double C12 = -0.000000014452093;
+        const double C13 = 6.5459673;
+        dlnPs = (-C8 / (T * T)) + C10 + (2.0 * C11 * T) + (3.0 * C12 * T * T) + (C13 / T);
+    }
+    else {
+        const double C1 = -5674.5359;
+        const double C3 = -0.009677843;
+        const double C4 = 0.00000062215701;
+        const double C5 = 0.0000000020747825;
+        const double C6 = -0.0000000000009484024;
+        const double C7 = 4.1635019;
+        dlnPs = (-C1 / (T * T)) + C3 + (2.0 * C4 * T) + (3.0 * C5 * T * T) + (4.0 * C6 * T * T * T) + (C7 / T);
+    }
+    // dPs/dT = Ps * dlnPs/dT [kPa/K]
+    return core_Psat(t) * dlnPs;
+}
+PSICRO_INLINE double core_stima_iniziale_t(double p_kpa) {
+    double a, b, p0;
+    // Magnus-Tetens (WMO / ASHRAE Lite)
+    if (p_kpa >= P_TRIPLO) {
+        a = 17.62;
+        b = 243.12;
+        p0 = 0.6112;
+    }
+    else { // Ghiaccio
+        a = 22.46;
+        b = 272.62;
+        p0 = 0.61115;
+    }
+    double L = log(p_kpa / p0);
+    return (b * L) / (a - L);
+}
+PSICRO_INLINE double core_TPsat(double p_kpa) {
+    if (p_kpa <= 0.0001) return -100.0; // Ghiaccio profondo
+    if (p_kpa > 20000.0) return 360.0;  // Punto critico
+    const psicro_tolleranze* tol = psicro_prec_attiva();
+    const double eps_p = tol->tpsat_eps_p;   // [kPa]
+    const double eps_t = tol->tpsat_eps_t;   // [°C]
+    const int max_iter = 100;
+    double t_curr = core_stima_iniziale_t(p_kpa);
+    double t_next = t_curr;
+    for (int iter = 0; iter < max_iter; iter++) {
+        double p_calc = core_Psat(t_curr);
+        double dPdt = core_dPsat_dt(t_curr);
+        if (fabs(dPdt) < 1e-15) break;
+        double error_p = p_calc - p_kpa;
+        double step = error_p / dPdt;
+        t_next = t_curr - step;
+        // AND tra precisione P e precisione T
+        if (fabs(error_p) < eps_p && fabs(step) < eps_t) {
+            psicro_ctx_conta(iter + 1, PSICRO_STATO_OK);
+            return t_next;
+        }
+        t_curr = t_next;
+    }
+    psicro_ctx_conta(max_iter, PSICRO_STATO_NON_CONV);
+    return t_next;
+}
+
+// --- TITOLO E ENTALPIA ---
+PSICRO_INLINE double core_xsat_t(double t, double patm) {
+    double ps = core_Psat(t);
+    if (ps >= patm) return 9.999; // Saturazione estrema
+    return (RAV * ps) / (patm - ps);
+}
+PSICRO_INLINE double core_x_t_ur(double t, double ur, double patm) {
+    if (ur < 0.000001) return 0.0;
+    if (fabs(ur - 100) < 0.000001) return core_xsat_t(t, patm);
+    double Pv = (ur / 100.0) * core_Psat(t);
+    return ((RAV * Pv) / (patm - Pv));
+}
+PSICRO_INLINE double core_h_t_x(double t, double x) { return (CPAS * t) + x * (LAMBDA + CPV * t); }
+PSICRO_INLINE double core_t_x_h(double x, double h) { return (h - x * LAMBDA) / (CPAS + x * CPV); }
+// Entalpia dell'acqua (liquida o ghiaccio) alla temperatura di bulbo umido
+PSICRO_INLINE double core_hw_bu(double tbu) {
+    return (tbu >= T_TRIPLO) ? (CPW * tbu) : (CPICE * tbu - LAMBDA_ICE);
+}
+
+// --- PUNTO DI RUGIADA ---
+PSICRO_INLINE double core_tr_x(double x, double patm) {
+    if (x <= 0.0) return -273.15;
+    return core_TPsat((x * patm) / (RAV + x));
+}
+
+// --- BULBO UMIDO ---
+// eq. bilancio (31) A.F.H. 2017: f(x,h,tbu)=0 con x e h fissati e tbu incognita
+PSICRO_INLINE double core_f_x_h_tbu(double x, double h, double tbu, double patm) {
+    double xs = core_xsat_t(tbu, patm);
+    double hs_bu = core_h_t_x(tbu, xs);
+    return h + (xs - x) * core_hw_bu(tbu) - hs_bu;
+}
+PSICRO_INLINE double core_tbu_x_h(double x, double h, double patm) {
+    // Metodo della bisezione
+    const int max_iter = 200;
+    const double tbu_low_min = -110.0;
+    const double tbu_high_max = 180.0;
+    const psicro_tolleranze* tol = psicro_prec_attiva();
+    const double eps = tol->tbu_eps_f;
+    const double eps_t = tol->bisez_eps_t;
+    double tbu_low = ((-(h / CPAS) - 5.0) < tbu_low_min) ? (-(h / CPAS) - 5.0) : tbu_low_min / 2; // innesca la bisezione anche con h=0
+    double tbu_high = ((h / CPAS) < tbu_high_max) ? (h / CPAS) : tbu_high_max / 2;
+    if (h < 0.0) {
+        double temp = tbu_high;
+        tbu_high = tbu_low;
+        tbu_low = temp;
+    }
+    double f_low = core_f_x_h_tbu(x, h, tbu_low, patm);
+    double f_high = core_f_x_h_tbu(x, h, tbu_high, patm);
+    int n_eval = 2;
+    // Regola l'intervallo se i segni sono uguali (al più ~60 passi fino ai limiti)
+    while (f_low * f_high > 0.0) {
+        tbu_high += 5.0;
+        tbu_low -= 5.0;
+        f_low = core_f_x_h_tbu(x, h, tbu_low, patm);
+        f_high = core_f_x_h_tbu(x, h, tbu_high, patm);
+        n_eval += 2;
+        if ((tbu_high > tbu_high_max) || (tbu_low < tbu_low_min)) { // nessuna soluzione
+            psicro_ctx_conta(n_eval, PSICRO_STATO_NO_SOL);
+            return -999;
+        }
+    }
+    for (int iter = 0; iter < max_iter; iter++) {
+        double tbu_mid = (tbu_low + tbu_high) / 2.0;
+        double f_mid = core_f_x_h_tbu(x, h, tbu_mid, patm);
+        n_eval++;
+        if (fabs(f_mid) < eps || fabs(tbu_high - tbu_low) < 2.0 * eps_t) {
+            psicro_ctx_conta(n_eval, PSICRO_STATO_OK);
+            return tbu_mid;
+        }
+        // Intervallo non più divisibile (es. salto acqua/ghiaccio a 0 °C): le
+        // iterazioni restanti non lo cambierebbero
+        if (tbu_mid == tbu_low || tbu_mid == tbu_high) {
+            psicro_ctx_conta(n_eval, PSICRO_STATO_OK);
+            return tbu_mid;
+        }
+        if (f_low * f_mid < 0.0) {
+            tbu_high = tbu_mid;
+        }
+        else {
+            tbu_low = tbu_mid;
+            f_low = f_mid;
+        }
+    }
+    psicro_ctx_conta(n_eval, PSICRO_STATO_NON_CONV);
+    return (tbu_low + tbu_high) / 2.0;
+}
+
+// --- STATO (t, x) CON TERMINI DI TEMPERATURA PRECALCOLATI ---
+// Per le coppie (t, v2) Psat(t), Psat(v2) e hw_bu(v2) non dipendono da PATM:
+// si calcolano una volta e si riusano per ogni pressione.
+typedef struct {
+    double ps_t;    // Psat(t)
+    double ps_2;    // Psat(v2) se v2 è tbu o tr
+    double hw_2;    // hw_bu(v2) se v2 è tbu
+} core_termini_t;
+
+PSICRO_INLINE void core_termini(int id2, double t, double v2, core_termini_t* k) {
+    k->ps_t = core_Psat(t);
+    k->ps_2 = (id2 == PSICRO_TBU || id2 == PSICRO_TR) ? core_Psat(v2) : 0.0;
+    k->hw_2 = (id2 == PSICRO_TBU) ? core_hw_bu(v2) : 0.0;
+}
+// Titolo dalla coppia (t, v2) alla pressione patm; NAN se la coppia non è gestita
+PSICRO_INLINE double core_x_coppia_t(int id2, double t, double v2, const core_termini_t* k, double patm) {
+    switch (id2) {
+    case PSICRO_UR: {
+        if (v2 < 0.000001) return 0.0;
+        if (fabs(v2 - 100) < 0.000001) return (k->ps_t >= patm) ? 9.999 : (RAV * k->ps_t) / (patm - k->ps_t);
+        double pv = (v2 / 100.0) * k->ps_t;
+        return (RAV * pv) / (patm - pv);
+    }
+    case PSICRO_X: return v2;
+    case PSICRO_H: return (v2 - (CPAS * t)) / (LAMBDA + CPV * t);
+    case PSICRO_VAU: return ((v2 * patm) / (RA * (t + 273.15)) - 1.0) * RAV;
+    case PSICRO_TBU: {
+        double xs_bu = (k->ps_2 >= patm) ? 9.999 : (RAV * k->ps_2) / (patm - k->ps_2);
+        double hs_bu = core_h_t_x(v2, xs_bu);
+        return (hs_bu - xs_bu * k->hw_2 - CPAS * t) / (LAMBDA + CPV * t - k->hw_2); // EQ. (33) AFH 2017
+    }
+    case PSICRO_TR: return (RAV * k->ps_2) / (patm - k->ps_2);
+    default: return NAN;
+    }
+}
+// Grandezza 'target' dallo stato (t, x) con Psat(t) già noto
+PSICRO_INLINE double core_target_t_x(int target, double t, double x, double ps_t, double patm) {
+    switch (target) {
+    case PSICRO_T: return t;
+    case PSICRO_X: return x;
+    case PSICRO_H: return core_h_t_x(t, x);
+    case PSICRO_VAU: return RA * (t + 273.15) * (1.0 + (((x <= 0.000001) ? 0.0 : x) / RAV)) / patm;
+    case PSICRO_UR: {
+        if (x <= 0.0) return 0.0;
+        double ur = ((x * patm) / (RAV + x)) / ps_t * 100.0;
+        if (ur >= 100.0) return 100.0;
+        return (ur <= 0.0) ? 0.0 : ur;
+    }
+    case PSICRO_TR: {
+        if (x <= 0.0) return -273.15;
+        double pv = (x * patm) / (RAV + x);
+        return (pv >= ps_t) ? t : core_TPsat(pv); // Saturazione
+    }
+    case PSICRO_TBU: {
+        if (x > 0.0 && (x * patm) / (RAV + x) >= ps_t) return t; // Saturazione
+        return core_tbu_x_h(x, core_h_t_x(t, x), patm);
+    }
+    default: return NAN;
+    }
+}
+
+// --- GRANDEZZE DA COPPIE DI INGRESSO (target_a_b) ---
+// Corpi delle 105 funzioni esportate: la pressione è un argomento esplicito
+// (solo dove serve) e le composizioni interne chiamano direttamente le altre
+// funzioni core_*, così il compilatore può espanderle in linea. Le funzioni
+// esportate in psicrometria.c sono involucri che passano PATM.
+PSICRO_INLINE double core_t_ur_x(double ur, double x, double patm);
+PSICRO_INLINE double core_t_ur_h(double ur, double h_target, double patm);
+PSICRO_INLINE double core_t_ur_vau(double ur_percent, double vau_target, double patm);
+PSICRO_INLINE double core_t_ur_tbu(double ur, double tbu, double patm);
+PSICRO_INLINE double core_t_ur_tr(double ur, double tr, double patm);
+PSICRO_INLINE double core_t_x_vau(double x, double vau, double patm);
+PSICRO_INLINE double core_t_x_tbu(double x, double tbu, double patm);
+PSICRO_INLINE double core_t_x_tr(double x, double tr);
+PSICRO_INLINE double core_t_vau_tbu(double vau, double tbu, double patm);
+PSICRO_INLINE double core_t_h_vau(double h, double vau, double patm);
+PSICRO_INLINE double core_t_h_tbu(double h, double tbu, double patm);
+PSICRO_INLINE double core_t_h_tr(double h, double tr, double patm);
+PSICRO_INLINE double core_t_vau_tr(double vau, double tr, double patm);
+PSICRO_INLINE double core_t_tbu_tr(double tbu, double tr, double patm);
+PSICRO_INLINE double core_ur_t_x(double t, double x, double patm);
+PSICRO_INLINE double core_ur_t_h(double t, double h, double patm);
+PSICRO_INLINE double core_ur_t_vau(double t, double vau, double patm);
+PSICRO_INLINE double core_ur_t_tbu(double t, double tbu, double patm);
+PSICRO_INLINE double core_ur_t_tr(double t, double tr, double patm);
+PSICRO_INLINE double core_ur_x_h(double x, double h, double patm);
+PSICRO_INLINE double core_ur_x_vau(double x, double vau, double patm);
+PSICRO_INLINE double core_ur_x_tbu(double x, double tbu, double patm);
+PSICRO_INLINE double core_ur_x_tr(double x, double tr);
+PSICRO_INLINE double core_ur_h_vau(double h, double vau, double patm);
+PSICRO_INLINE double core_ur_h_tbu(double h, double tbu, double patm);
+PSICRO_INLINE double core_ur_h_tr(double h, double tr, double patm);
+PSICRO_INLINE double core_ur_vau_tbu(double vau, double tbu, double patm);
+PSICRO_INLINE double core_ur_vau_tr(double vau, double tr, double patm);
+PSICRO_INLINE double core_ur_tbu_tr(double tbu, double tr, double patm);
+PSICRO_INLINE double core_x_t_h(double t, double h);
+PSICRO_INLINE double core_x_t_vau(double t, double vau, double patm);
+PSICRO_INLINE double core_x_t_tbu(double t, double tbu, double patm);
+PSICRO_INLINE double core_x_t_tr(double t, double tr, double patm);
+PSICRO_INLINE double core_x_ur_h(double ur, double h, double patm);
+PSICRO_INLINE double core_x_ur_vau(double ur, double vau, double patm);
+PSICRO_INLINE double core_x_ur_tbu(double ur, double tbu, double patm);
+PSICRO_INLINE double core_x_ur_tr(double ur, double tr, double patm);
+PSICRO_INLINE double core_x_h_vau(double h, double vau, double patm);
+PSICRO_INLINE double core_x_h_tbu(double h, double tbu, double patm);
+PSICRO_INLINE double core_x_h_tr(double h, double tr, double patm);
+PSICRO_INLINE double core_x_vau_tbu(double vau, double tbu, double patm);
+PSICRO_INLINE double core_x_vau_tr(double vau, double tr, double patm);
+PSICRO_INLINE double core_x_tbu_tr(double tbu, double tr, double patm);
+PSICRO_INLINE double core_h_t_ur(double t, double ur, double patm);
+PSICRO_INLINE double core_h_t_vau(double t, double vau, double patm);
+PSICRO_INLINE double core_h_t_tbu(double t, double tbu, double patm);
+PSICRO_INLINE double core_h_t_tr(double t, double tr, double patm);
+PSICRO_INLINE double core_h_ur_x(double ur, double x, double patm);
+PSICRO_INLINE double core_h_ur_vau(double ur, double vau, double patm);
+PSICRO_INLINE double core_h_ur_tr(double ur, double tr, double patm);
+PSICRO_INLINE double core_h_ur_tbu(double ur, double tbu, double patm);
+PSICRO_INLINE double core_h_x_tbu(double x, double tbu, double patm);
+PSICRO_INLINE double core_h_x_tr(double x, double tr, double patm);
+PSICRO_INLINE double core_h_x_vau(double x, double vau, double patm);
+PSICRO_INLINE double core_h_vau_tbu(double vau, double tbu, double patm);
+PSICRO_INLINE double core_h_vau_tr(double vau, double tr, double patm);
+PSICRO_INLINE double core_h_tbu_tr(double tbu, double tr, double patm);
+PSICRO_INLINE double core_vau_t_ur(double t, double ur, double patm);
+PSICRO_INLINE double core_vau_t_x(double t, double x, double patm);
+PSICRO_INLINE double core_vau_t_h(double t, double h, double patm);
+PSICRO_INLINE double core_vau_t_tbu(double t, double tbu, double patm);
+PSICRO_INLINE double core_vau_t_tr(double t, double tr, double patm);
+PSICRO_INLINE double core_vau_ur_x(double ur, double x, double patm);
+PSICRO_INLINE double core_vau_ur_h(double ur, double h, double patm);
+PSICRO_INLINE double core_vau_ur_tbu(double ur, double tbu, double patm);
+PSICRO_INLINE double core_vau_ur_tr(double ur, double tr, double patm);
+PSICRO_INLINE double core_vau_x_h(double x, double h, double patm);
+PSICRO_INLINE double core_vau_x_tbu(double x, double tbu, double patm);
+PSICRO_INLINE double core_vau_x_tr(double x, double tr);
+PSICRO_INLINE double core_vau_h_tbu(double h, double tbu, double patm);
+PSICRO_INLINE double core_vau_h_tr(double h, double tr, double patm);
+PSICRO_INLINE double core_vau_tbu_tr(double tbu, double tr, double patm);
+PSICRO_INLINE double core_tbu_t_ur(double t, double ur, double patm);
+PSICRO_INLINE double core_tbu_t_x(double t, double x, double patm);
+PSICRO_INLINE double core_tbu_t_h(double t, double h, double patm);
+PSICRO_INLINE double core_tbu_t_vau(double t, double vau, double patm);
+PSICRO_INLINE double core_tbu_t_tr(double t, double tr, double patm);
+PSICRO_INLINE double core_tbu_ur_x(double ur, double x, double patm);
+PSICRO_INLINE double core_tbu_ur_h(double ur, double h, double patm);
+PSICRO_INLINE double core_tbu_ur_vau(double ur, double vau, double patm);
+PSICRO_INLINE double core_tbu_ur_tr(double ur, double tr, double patm);
+PSICRO_INLINE double core_tbu_x_vau(double x, double vau, double patm);
+PSICRO_INLINE double core_tbu_x_tr(double x, double tr);
+PSICRO_INLINE double core_tbu_h_vau(double h, double vau, double patm);
+PSICRO_INLINE double core_tbu_h_tr(double h, double tr, double patm);
+PSICRO_INLINE double core_tbu_vau_tr(double vau, double tr, double patm);
+PSICRO_INLINE double core_tr_t_ur(double t, double ur, double patm);
+PSICRO_INLINE double core_tr_t_x(double t, double x, double patm);
+PSICRO_INLINE double core_tr_t_h(double t, double h, double patm);
+PSICRO_INLINE double core_tr_t_vau(double t, double vau, double patm);
+PSICRO_INLINE double core_tr_t_tbu(double t, double tbu, double patm);
+PSICRO_INLINE double core_tr_ur_x(double ur, double x, double patm);
+PSICRO_INLINE double core_tr_ur_h(double ur, double h, double patm);
+PSICRO_INLINE double core_tr_ur_vau(double ur, double vau, double patm);
+PSICRO_INLINE double core_tr_ur_tbu(double ur, double tbu, double patm);
+PSICRO_INLINE double core_tr_x_h(double x, double h, double patm);
+PSICRO_INLINE double core_tr_x_vau(double x, double vau, double patm);
+PSICRO_INLINE double core_tr_x_tbu(double x, double tbu, double patm);
+PSICRO_INLINE double core_tr_h_vau(double h, double vau, double patm);
+PSICRO_INLINE double core_tr_h_tbu(double h, double tbu, double patm);
+PSICRO_INLINE double core_tr_vau_tbu(double vau, double tbu, double patm);
+
+// --- TARGET 0: TEMPERATURA (t) ---
+PSICRO_INLINE double core_t_ur_x(double ur, double x, double patm) {
+    if (ur <= 0) return -999.0; // Ritorna volutamente un valore non fisico
+    double ps = (x * patm) / ((ur / 100.0) * (RAV + x));
+    return core_TPsat(ps);
+}
+PSICRO_INLINE double core_t_ur_h(double ur, double h_target, double patm) {
+    double phi = ur / 100.0;
+    int max_iter = 100;
+    if (phi <= 0.0) return h_target / CPAS;
+    // Stima iniziale
+    double t_curr = h_target / (CPAS + phi * 0.05 * LAMBDA);
+    const double eps_t = psicro_prec_attiva()->newton_eps_t_h;
+    for (int i = 0; i < max_iter; i++) {
+        double ps = core_Psat(t_curr);
+        double dps = core_dPsat_dt(t_curr);
+        double L_current = LAMBDA;
+        double pv = phi * ps;
+        double denom = patm - pv;
+        if (denom < 0.001) denom = 0.001;
+        double x = (RAV * pv) / denom;
+        double dxdt = (RAV * phi * dps * patm) / (denom * denom);
+        // f(t) = h_attuale - h_target
+        double f_t = (CPAS * t_curr) + (x * (L_current + CPV * t_curr)) - h_target;
+        // f'(t) = dh/dt
+        double df_dt = CPAS + dxdt * (L_current + CPV * t_curr) + x * CPV;
+        double step = f_t / df_dt;
+        // Damping
+        if (step > 5.0) step = 5.0;
+        if (step < -5.0) step = -5.0;
+        t_curr -= step;
+        if (fabs(step) < eps_t) {
+            psicro_ctx_conta(i + 1, PSICRO_STATO_OK);
+            return t_curr;
+        }
+    }
+    psicro_ctx_conta(max_iter, PSICRO_STATO_NON_CONV);
+    return t_curr;
+}
+PSICRO_INLINE double core_t_ur_vau(double ur_percent, double vau_target, double patm) {//ok testato
+    double phi = ur_percent / 100.0;
+    if (phi < 0.0) phi = 0.0;
+    if (phi > 1.0) phi = 1.0;
+    // 1. STIMA INIZIALE ANALITICA 
+    // Usiamo la formula dell'aria secca: T = (P * V) / R
+    double t_curr = (patm * vau_target / RA) - 273.15;
+    const double eps_t = psicro_prec_attiva()->newton_eps_t_vau;
+    const int max_iter = 50;
+    double t_next = t_curr;
+    //2. CICLO DI NEWTON-RAPHSON
+    int i;
+    for (i = 0; i < max_iter; i++) {
+        double ps = core_Psat(t_curr);
+        double dps = core_dPsat_dt(t_curr);
+        double T_kelvin = t_curr + 273.15;
+        // Funzione obiettivo f(t) derivata dalla legge dei gas
+        // f(t) = Ra​*(t+273.15) − vau​⋅(Patm​−phi⋅Psat​(t))=0
+        double f_t = (RA * T_kelvin) - vau_target * (patm - phi * ps);
+        // f'(t) = Ra + vau * phi * dPsat/dt
+        double df_dt = RA + vau_target * phi * dps;
+        if (fabs(df_dt) < 1e-15) break;// Protezione divisione per zero
+        double step = f_t / df_dt;
+        t_next = t_curr - step;
+        if (fabs(step) < eps_t) {
+            psicro_ctx_conta(i + 1, PSICRO_STATO_OK);
+            return t_next;
+        }
+        t_curr = t_next;
+    }
+    // Limite esaurito: max_iter valutazioni; uscita per derivata nulla: i + 1
+    psicro_ctx_conta((i < max_iter) ? i + 1 : max_iter, PSICRO_STATO_NON_CONV);
+    return t_curr;
+}
+PSICRO_INLINE double core_t_ur_tbu(double ur, double tbu, double patm) {
+    if (fabs(ur - 100.0) < 0.00001) return tbu;
+    //Algoritmo di bisezione
+    double t_low = -5.0;
+    double t_high = tbu;//t<=tbu sempre
+    double t_mid;
+    double f_low, f_high, f_mid, h, hs_bu, hw_bu, x, xs_bu;
+    const psicro_tolleranze* tol = psicro_prec_attiva();
+    if (tbu >= T_TRIPLO) {
+        hw_bu = CPW * tbu;
+    }
+    else {
+        hw_bu = CPICE * tbu - LAMBDA_ICE;
+        t_high = 0.0;
+    }
+    xs_bu = core_xsat_t(tbu, patm);
+    hs_bu = core_h_t_x(tbu, xs_bu);
+    // f ai due estremi: si ricalcola solo l'estremo che si sposta
+    h = core_h_t_ur(t_low, ur, patm);
+    x = core_x_t_ur(t_low, ur, patm);
+    f_low = h - hs_bu + (xs_bu - x) * hw_bu;
+    h = core_h_t_ur(t_high, ur, patm);
+    x = core_x_t_ur(t_high, ur, patm);
+    f_high = h - hs_bu + (xs_bu - x) * hw_bu;
+    int n_eval = 2;
+    // Espansioni e bisezioni condividono il limite di iterazioni
+    for (int iter = 0; iter < PSICRO_MAX_ITER_BISEZ; iter++) {
+        // espandi l'intervallo se non racchiude lo zero (entro gli stessi limiti di tbu_x_h):
+        // ogni estremo si ferma al proprio limite, senza soluzione solo se lo sono entrambi
+        if (f_low * f_high > 0) {
+            if (t_low <= -110.0 && t_high >= 180.0) {
+                psicro_ctx_conta(n_eval, PSICRO_STATO_NO_SOL);
+                return -999;
+            }
+            if (t_low > -110.0) {
+                t_low = (t_low - 5.0 > -110.0) ? t_low - 5.0 : -110.0;
+                h = core_h_t_ur(t_low, ur, patm);
+                x = core_x_t_ur(t_low, ur, patm);
+                f_low = h - hs_bu + (xs_bu - x) * hw_bu;
+                n_eval++;
+            }
+            if (t_high < 180.0) {
+                t_high = (t_high + 5.0 < 180.0) ? t_high + 5.0 : 180.0;
+                h = core_h_t_ur(t_high, ur, patm);
+                x = core_x_t_ur(t_high, ur, patm);
+                f_high = h - hs_bu + (xs_bu - x) * hw_bu;
+                n_eval++;
+            }
+            continue;
+        }
+        t_mid = 0.5 * (t_low + t_high);
+        h = core_h_t_ur(t_mid, ur, patm);
+        x = core_x_t_ur(t_mid, ur, patm);
+        f_mid = h - hs_bu + (xs_bu - x) * hw_bu;
+        n_eval++;
+        if (fabs(f_mid) < tol->t_tbu_eps_f || (t_high - t_low) < 2.0 * tol->bisez_eps_t) {
+            psicro_ctx_conta(n_eval, PSICRO_STATO_OK);
+            return t_mid;
+        }
+        // Aggiorna l'intervallo
+        if (f_low * f_mid < 0) {
+            t_high = t_mid;
+            f_high = f_mid;
+        }
+        else {
+            t_low = t_mid;
+            f_low = f_mid;
+        }
+    }
+    psicro_ctx_conta(n_eval, PSICRO_STATO_NON_CONV);
+    return 0.5 * (t_low + t_high);
+}
+PSICRO_INLINE double core_t_ur_tr(double ur, double tr, double patm) { return core_t_ur_x(ur, core_x_t_ur(tr, 100, patm), patm); }
+PSICRO_INLINE double core_t_x_vau(double x, double vau, double patm) { return vau * (patm / RA) / (1 + (RV / RA) * x) - 273.15; } //ok analitica  
+PSICRO_INLINE double core_t_x_tbu(double x, double tbu, double patm) {
+    double hs_bu, xs_bu, hw_bu, t;
+    xs_bu = core_xsat_t(tbu, patm);
+    hs_bu = core_h_t_x(tbu, xs_bu);
+    if (tbu >= T_TRIPLO) {
+        hw_bu = CPW * tbu;
+    }
+    else {
+        hw_bu = CPICE * tbu - LAMBDA_ICE;
+    }
+    t = (hs_bu - (xs_bu - x) * hw_bu - x * LAMBDA) / (CPAS + x * CPV);
+    return t;
+}
+PSICRO_INLINE double core_t_x_tr(double x, double tr) {
+    if ((x <= 0.000001) || (tr <= -273.15)) return -999;
+    return tr;
+}
+PSICRO_INLINE double core_t_vau_tbu(double vau, double tbu, double patm) {//da testare 
+    double c1, c2, c3, delta, t1, t2, t_final;
+    double xs = core_xsat_t(tbu, patm);
+    double vau_sat = core_vau_t_x(tbu, xs, patm);
+    if (fabs(vau - vau_sat) < 0.000001) return tbu; // caso di saturazione
+    // eguaglio la definizione di vau e Tbu e risolvo il polinomio in t c1*t^2+c2*t+c3=0
+    double hwbu = (tbu >= T_TRIPLO) ? (CPW * tbu) : (CPICE * tbu - LAMBDA_ICE);
+    double xsbu = core_xsat_t(tbu, patm);
+    double hsbu = core_h_t_x(tbu, xsbu);
+    double k = hsbu - xsbu * hwbu;
+    c1 = RA * CPV - RV * CPAS;
+    c2 = RA * (LAMBDA - hwbu) + RV * k + 273.15 * (RA * CPV - RV * CPAS) - vau * patm * CPV;
+    c3 = +273.15 * (RA * (LAMBDA - hwbu) + RV * k) - vau * patm * (LAMBDA - hwbu);
+    delta = c2 * c2 - 4.0 * c1 * c3;
+    if (delta < 0.0) return NAN;
+    t1 = (-c2 + sqrt(delta)) / (2.0 * c1);
+    t2 = (-c2 - sqrt(delta)) / (2.0 * c1);
+    // La temperatura a bulbo asciutto deve essere >= tbu
+    t_final = (t1 >= tbu) ? t1 : t2;
+    return t_final;
+}// da porre in OFF per pre release
+PSICRO_INLINE double core_t_h_vau(double h, double vau, double patm) {
+    double c1, c2, c3, delta, t1, t2, t_final;
+    double L = LAMBDA; // Partiamo con l'ipotesi Liquido
+    // Eseguiamo il calcolo analitico
+    c1 = CPV - CPAS / RAV;
+    c2 = 273.15 * (CPV - CPAS / RAV) + L + h / RAV - vau * CPV * patm / RA;
+    c3 = 273.15 * (L + h / RAV) - L * vau * patm / RA;
+    delta = c2 * c2 - 4.0 * c1 * c3;
+    if (delta < 0.0) return NAN;
+    t1 = (-c2 + sqrt(delta)) / (2.0 * c1);
+    t2 = (-c2 - sqrt(delta)) / (2.0 * c1);
+    t_final = (t1 > t2) ? t1 : t2;
+    return t_final;
+}
+PSICRO_INLINE double core_t_h_tbu(double h, double tbu, double patm) {
+    double x = core_x_h_tbu(h, tbu, patm);
+    return core_t_x_h(x, h);
+}
+PSICRO_INLINE double core_t_h_tr(double h, double tr, double patm) {
+    return core_t_x_h(core_x_t_ur(tr, 100, patm), h);
+}
+PSICRO_INLINE double core_t_vau_tr(double vau, double tr, double patm) {
+    if ((tr <= -273.15) && (vau >= 0)) return ((vau * patm / RA) - 273.15);
+    return core_t_x_vau(core_x_t_ur(tr, 100, patm), vau, patm);
+}
+PSICRO_INLINE double core_t_tbu_tr(double tbu, double tr, double patm) {
+    return core_t_x_tbu(core_x_t_ur(tr, 100, patm), tbu, patm);
+}
+// --- TARGET 1: UMIDITÀ RELATIVA (ur) ---
+PSICRO_INLINE double core_ur_t_x(double t, double x, double patm) {
+    if (x <= 0.0) return 0.0;
+    double Ps = core_Psat(t);
+    double Pv = (x * patm) / (RAV + x);
+    double ur = (Pv / Ps) * 100.0;
+    if (ur >= 100.0) return 100.0;
+    if (ur <= 0.0) return 0.0;
+    return ur;
+}
+PSICRO_INLINE double core_ur_t_h(double t, double h, double patm) {
+    double x = core_x_t_h(t, h);
+    double ur = core_ur_t_x(t, x, patm);
+    if (fabs(ur - 100.0) < 0.000001) return 100.0;
+    if (ur <= 0.000001) return 0.0;
+    return ur;
+}
+PSICRO_INLINE double core_ur_t_vau(double t, double vau, double patm) {
+    double T_kelvin = t + 273.15;
+    double x = ((vau * patm) / (RA * T_kelvin) - 1.0) * RAV;
+    double ur = core_ur_t_x(t, x, patm);
+    if (ur >= 100.0) return 100.0;
+    if (ur <= 0.0) return 0.0;
+    return ur;
+}
+PSICRO_INLINE double core_ur_t_tbu(double t, double tbu, double patm) {
+    if (fabs(t - tbu) < 0.000001) return 100;
+    double x = core_x_t_tbu(t, tbu, patm);
+    return core_ur_t_x(t, x, patm);
+}
+PSICRO_INLINE double core_ur_t_tr(double t, double tr, double patm) {
+    if (tr >= t) return 100.0;
+    if (tr <= -273.15) return 0.0;
+    double ur = core_ur_t_x(t, core_x_t_ur(tr, 100, patm), patm);
+    if (ur >= 100.0) return 100.0;
+    if (ur <= 0.0) return 0.0;
+    return ur;
+}
+PSICRO_INLINE double core_ur_x_h(double x, double h, double patm) {
+    double ur = core_ur_t_h(core_t_x_h(x, h), h, patm);
+    if (ur >= 100.0) return 100.0;
+    if (ur <= 0.0) return 0.0;
+    return ur;
+}
+PSICRO_INLINE double core_ur_x_vau(double x, double vau, double patm) {
+    double t = (vau * patm / (RA + RV * x)) - 273.15;
+    double ur = core_ur_t_x(t, x, patm);
+    if (ur >= 100.0) return 100.0;
+    if (ur <= 0.0) return 0.0;
+    return ur;
+}
+PSICRO_INLINE double core_ur_x_tbu(double x, double tbu, double patm) {
+    double t = core_t_x_tbu(x, tbu, patm);
+    return core_ur_t_x(t, x, patm);
+}
+PSICRO_INLINE double core_ur_x_tr(double x, double tr) {
+    if ((x <= 0.0) || (tr <= -273.15)) return 0.0;
+    return -999;
+}
+PSICRO_INLINE double core_ur_h_vau(double h, double vau, double patm) {
+    double t = core_t_h_vau(h, vau, patm);
+    double ur = core_ur_t_h(t, h, patm);
+    if (ur >= 100.0) return 100.0;
+    if (ur <= 0.0) return 0.0;
+    return ur;
+}
+PSICRO_INLINE double core_ur_h_tbu(double h, double tbu, double patm) {
+    double t = core_t_h_tbu(h, tbu, patm);
+    double ur = core_ur_t_h(t, h, patm);
+    if (ur >= 100.0) return 100.0;
+    if (ur <= 0.0) return 0.0;
+    return ur;
+}
+PSICRO_INLINE double core_ur_h_tr(double h, double tr, double patm) {
+    if (tr <= -273.15) return 0.0;
+    double ur = core_ur_x_h(core_x_t_ur(tr, 100, patm), h, patm);
+    if (ur >= 100.0) return 100.0;
+    if (ur <= 0.0) return 0.0;
+    return ur;
+}
+PSICRO_INLINE double core_ur_vau_tbu(double vau, double tbu, double patm) {
+    double t = core_t_vau_tbu(vau, tbu, patm);
+    return core_ur_t_vau(t, vau, patm);
+}
+PSICRO_INLINE double core_ur_vau_tr(double vau, double tr, double patm) {
+    if (tr <= -273.15) return 0.0;
+    double ur = core_ur_x_vau(core_x_t_ur(tr, 100, patm), vau, patm);
+    if (ur >= 100.0) return 100.0;
+    if (ur <= 0.0) return 0.0;
+    return ur;
+}
+PSICRO_INLINE double core_ur_tbu_tr(double tbu, double tr, double patm) {
+    double t = core_t_tbu_tr(tbu, tr, patm);
+    return core_ur_t_tbu(t, tbu, patm);
+}
+// --- TARGET 2: TITOLO (x) ---
+PSICRO_INLINE double core_x_t_h(double t, double h) { return ((h - (CPAS * t)) / (LAMBDA + CPV * t)); }
+PSICRO_INLINE double core_x_t_vau(double t, double vau, double patm) { return ((vau * patm) / (RA * (t + 273.15)) - 1.0) * RAV; }
+PSICRO_INLINE double core_x_t_tbu(double t, double tbu, double patm) {// analitica
+    double xs_bu, hs_bu, hw_bu;
+    xs_bu = core_xsat_t(tbu, patm);
+    hs_bu = core_h_t_x(tbu, xs_bu);
+    if (tbu >= T_TRIPLO) {
+        hw_bu = CPW * tbu;
+    }
+    else {
+        hw_bu = CPICE * tbu - LAMBDA_ICE;
+    }
+    return ((hs_bu - xs_bu * hw_bu - CPAS * t) / (LAMBDA + CPV * t - hw_bu));//EQ. (33) AFH 2017
+}
+PSICRO_INLINE double core_x_t_tr(double t, double tr, double patm) {
+    (void)t;
+    double Ps_tr = core_Psat(tr);
+    return (RAV * Ps_tr) / (patm - Ps_tr);
+}
+PSICRO_INLINE double core_x_ur_h(double ur, double h, double patm) { return core_x_t_h(core_t_ur_h(ur, h, patm), h); }
+PSICRO_INLINE double core_x_ur_vau(double ur, double vau, double patm) { return core_x_t_ur(core_t_ur_vau(ur, vau, patm), ur, patm); }
+PSICRO_INLINE double core_x_ur_tbu(double ur, double tbu, double patm) {
+    double t = core_t_ur_tbu(ur, tbu, patm);
+    return core_x_t_ur(t, ur, patm);
+}
+PSICRO_INLINE double core_x_ur_tr(double ur, double tr, double patm) { (void)ur; return core_x_t_ur(tr, 100, patm); }
+PSICRO_INLINE double core_x_h_vau(double h, double vau, double patm) { return core_x_t_h(core_t_h_vau(h, vau, patm), h); }
+PSICRO_INLINE double core_x_h_tbu(double h, double tbu, double patm) {//analitica
+    double xs_bu, hs_bu, hw_bu;
+    xs_bu = core_xsat_t(tbu, patm);
+    hs_bu = core_h_t_x(tbu, xs_bu);
+    if (tbu >= T_TRIPLO) {
+        hw_bu = CPW * tbu;
+    }
+    else {
+        hw_bu = CPICE * tbu - LAMBDA_ICE;
+    }
+    return (xs_bu - ((hs_bu - h) / (hw_bu)));//EQ. (33) AFH 2017
+}
+PSICRO_INLINE double core_x_h_tr(double h, double tr, double patm) {
+    (void)h;
+    return core_xsat_t(tr, patm);
+}
+PSICRO_INLINE double core_x_vau_tbu(double vau, double tbu, double patm) {
+    double t = core_t_vau_tbu(vau, tbu, patm);
+    return core_x_t_tbu(t, tbu, patm);
+}
+PSICRO_INLINE double core_x_vau_tr(double vau, double tr, double patm) { (void)vau; return core_x_t_ur(tr, 100, patm); }
+PSICRO_INLINE double core_x_tbu_tr(double tbu, double tr, double patm) { (void)tbu; return core_x_t_ur(tr, 100, patm); }
+// --- TARGET 3: ENTALPIA (h) --- 
+PSICRO_INLINE double core_h_t_ur(double t, double ur, double patm) {
+    if (ur <= 0.0001) return CPAS * t;
+    double x = core_x_t_ur(t, ur, patm);
+    return (CPAS * t) + x * (LAMBDA + CPV * t);
+}
+PSICRO_INLINE double core_h_t_vau(double t, double vau, double patm) {
+    double T_kelvin = t + 273.15;
+    double x = ((vau * patm) / (RA * T_kelvin) - 1.0) * RAV;
+    return core_h_t_x(t, x);
+}//ANALITICA
+PSICRO_INLINE double core_h_t_tbu(double t, double tbu, double patm) {
+    double x = core_x_t_tbu(t, tbu, patm);
+    return core_h_t_x(t, x);
+}
+PSICRO_INLINE double core_h_t_tr(double t, double tr, double patm) {
+    if (tr <= -273.15) return CPAS * t;
+    double x = core_x_t_tr(t, tr, patm);
+    return core_h_t_x(t, x);
+}
+PSICRO_INLINE double core_h_ur_x(double ur, double x, double patm) {
+    if ((ur <= 0.0001) || (x <= 0.000001)) return -999;
+    return core_h_t_x(core_t_ur_x(ur, x, patm), x);
+}
+PSICRO_INLINE double core_h_ur_vau(double ur, double vau, double patm) {
+    double t = core_t_ur_vau(ur, vau, patm);
+    return core_h_t_ur(t, ur, patm);
+}
+PSICRO_INLINE double core_h_ur_tr(double ur, double tr, double patm) {
+    if ((ur <= 0.0001) || (tr <= -273.15)) return -999;
+    return core_h_ur_x(ur, core_x_t_ur(tr, 100, patm), patm);
+}
+PSICRO_INLINE double core_h_ur_tbu(double ur, double tbu, double patm) {
+    double t = core_t_ur_tbu(ur, tbu, patm);
+    return core_h_t_ur(t, ur, patm);
+}
+PSICRO_INLINE double core_h_x_tbu(double x, double tbu, double patm) {
+    double hs_bu, xs_bu, hw_bu;
+    xs_bu = core_xsat_t(tbu, patm);
+    hs_bu = core_h_t_x(tbu, xs_bu);
+    if (tbu >= T_TRIPLO) {
+        hw_bu = CPW * tbu;
+    }
+    else
+    {
+        hw_bu = CPICE * tbu - LAMBDA_ICE;
+    }
+    return (hs_bu - (xs_bu - x) * hw_bu);
+}
+PSICRO_INLINE double core_h_x_tr(double x, double tr, double patm) {
+    if ((fabs(x - core_xsat_t(tr, patm))) < 0.000001) return core_h_t_x(tr, x);
+    return 999;
+}
+PSICRO_INLINE double core_h_x_vau(double x, double vau, double patm) {
+    //if (x <= 0.000001) return -999;
+    double t = (vau * patm / (RA + RV * x)) - 273.15;
+    return core_h_t_x(t, x);
+}
+PSICRO_INLINE double core_h_vau_tbu(double vau, double tbu, double patm) {
+    double t = core_t_vau_tbu(vau, tbu, patm);
+    return core_h_t_tbu(t, tbu, patm);
+}
+PSICRO_INLINE double core_h_vau_tr(double vau, double tr, double patm) {
+    if (tr <= -273.15) {//aria secca 
+        double t = core_t_vau_tr(vau, tr, patm);
+        return CPAS * t;
+    };
+    return core_h_x_vau(core_x_t_ur(tr, 100, patm), vau, patm);
+}
+PSICRO_INLINE double core_h_tbu_tr(double tbu, double tr, double patm) {
+    double x = core_x_t_ur(tr, 100, patm);
+    return core_h_x_tbu(x, tbu, patm);
+}
+// --- TARGET 4: VOLUME SPECIFICO (vau) ---
+PSICRO_INLINE double core_vau_t_ur(double t, double ur, double patm) {
+    double ur2 = ur;
+    if (ur <= 0.001) ur2 = 0.0;
+    if (ur >= 100.0) ur2 = 100.0;
+    return (RA * (t + 273.15) * (1.0 + (core_x_t_ur(t, ur2, patm) / RAV)) / patm);
+}
+PSICRO_INLINE double core_vau_t_x(double t, double x, double patm) {
+    double x2 = x;
+    if (x <= 0.000001) { x2 = 0.0; }
+    return (RA * (t + 273.15) * (1.0 + (x2 / RAV)) / patm);
+}
+PSICRO_INLINE double core_vau_t_h(double t, double h, double patm) {
+    double x = core_x_t_h(t, h);
+    return core_vau_t_x(t, x, patm);
+}
+PSICRO_INLINE double core_vau_t_tbu(double t, double tbu, double patm) {
+    double x = core_x_t_tbu(t, tbu, patm);
+    return core_vau_t_x(t, x, patm);
+}
+PSICRO_INLINE double core_vau_t_tr(double t, double tr, double patm) {
+    double x = core_x_t_tr(t, tr, patm);
+    return core_vau_t_x(t, x, patm);
+}
+PSICRO_INLINE double core_vau_ur_x(double ur, double x, double patm) {
+    if (ur <= 0.001 || x <= 0.000001) return 999;
+    return core_vau_t_x(core_t_ur_x(ur, x, patm), x, patm);
+}
+PSICRO_INLINE double core_vau_ur_h(double ur, double h, double patm) {
+    return core_vau_t_h(core_t_ur_h(ur, h, patm), h, patm);
+} //cambiata rispetto a .bas
+PSICRO_INLINE double core_vau_ur_tbu(double ur, double tbu, double patm) {
+    double t = core_t_ur_tbu(ur, tbu, patm);
+    double x = core_x_t_ur(t, ur, patm); // = x_ur_tbu senza ripetere la bisezione
+    return core_vau_t_x(t, x, patm);
+}
+PSICRO_INLINE double core_vau_ur_tr(double ur, double tr, double patm) {
+    double ur2 = ur;
+    if (ur <= 0.001) ur2 = 0.0;
+    if (ur >= 100.0) ur2 = 100.0;
+    return core_vau_ur_x(ur2, core_x_t_ur(tr, 100, patm), patm);
+}
+PSICRO_INLINE double core_vau_x_h(double x, double h, double patm) {
+    double x2 = x;
+    if (x <= 0.000001) x2 = 0.0;
+    return core_vau_t_x(core_t_x_h(x2, h), x2, patm);
+}
+PSICRO_INLINE double core_vau_x_tbu(double x, double tbu, double patm) { return core_vau_t_x(core_t_x_tbu(x, tbu, patm), x, patm); }
+PSICRO_INLINE double core_vau_x_tr(double x, double tr) { (void)x; (void)tr; return 999; }
+PSICRO_INLINE double core_vau_h_tbu(double h, double tbu, double patm) {
+    double x = core_x_h_tbu(h, tbu, patm);
+    double t = core_t_x_h(x, h); // = t_h_tbu
+    return core_vau_t_x(t, x, patm);
+}
+PSICRO_INLINE double core_vau_h_tr(double h, double tr, double patm) {
+    double x = core_x_t_ur(tr, 100, patm);
+    double t = core_t_x_h(x, h);
+    return core_vau_t_x(t, x, patm);
+}
+PSICRO_INLINE double core_vau_tbu_tr(double tbu, double tr, double patm) {
+    double x = core_x_t_ur(tr, 100, patm);
+    double t = core_t_x_tbu(x, tbu, patm);
+    return core_vau_t_x(t, x, patm);
+}
+// --- TARGET 5: BULBO UMIDO (tbu) ---
+PSICRO_INLINE double core_tbu_t_ur(double t, double ur, double patm) {
+    if (fabs(ur - 100.0) <= 0.00001) return t; // sicurezza
+    double x = core_x_t_ur(t, ur, patm);
+    double h = (ur <= 0.0001) ? CPAS * t : core_h_t_x(t, x); // = h_t_ur con x già noto
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_t_x(double t, double x, double patm) {
+    double h = core_h_t_x(t, x);
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_t_h(double t, double h, double patm) {
+    double x = core_x_t_h(t, h);
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_t_vau(double t, double vau, double patm) {
+    double x = core_x_t_vau(t, vau, patm);
+    double h = core_h_t_vau(t, vau, patm);
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_t_tr(double t, double tr, double patm) {
+    if (fabs(t - tr) < 0.000001) return t;
+    double x = core_x_t_tr(t, tr, patm);
+    double h = core_h_t_x(t, x);
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_ur_x(double ur, double x, double patm) {
+    if (fabs(ur - 100.0) <= 0.00001) core_t_ur_x(100, x, patm);
+    double h = core_h_ur_x(ur, x, patm);
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_ur_h(double ur, double h, double patm) {
+    double x = core_x_ur_h(ur, h, patm);
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_ur_vau(double ur, double vau, double patm) {
+    double t = core_t_ur_vau(ur, vau, patm); // un solo Newton per x e h
+    double x = core_x_t_ur(t, ur, patm);
+    double h = (ur <= 0.0001) ? CPAS * t : core_h_t_x(t, x);
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_ur_tr(double ur, double tr, double patm) {
+    if (fabs(ur - 100.0) < 0.000001) return tr;
+    double x_calc = core_x_ur_tr(ur, tr, patm);
+    double h_calc = core_h_ur_x(ur, x_calc, patm);
+    return core_tbu_x_h(x_calc, h_calc, patm);
+}
+PSICRO_INLINE double core_tbu_x_vau(double x, double vau, double patm) {
+    double h = core_h_x_vau(x, vau, patm);
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_x_tr(double x, double tr) {
+    (void)x; (void)tr;
+    return 999;
+} // In saturazione t = tbu = tr}
+PSICRO_INLINE double core_tbu_h_vau(double h, double vau, double patm) {
+    double x = core_x_h_vau(h, vau, patm);
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_h_tr(double h, double tr, double patm) {
+    double x = core_x_h_tr(h, tr, patm);
+    return core_tbu_x_h(x, h, patm);
+}
+PSICRO_INLINE double core_tbu_vau_tr(double vau, double tr, double patm) {
+    double x = core_x_vau_tr(vau, tr, patm);
+    double h = core_h_x_vau(x, vau, patm);
+    return core_tbu_x_h(x, h, patm);
+}
+
+// --- TARGET 6: PUNTO DI RUGIADA (tr) ---
+PSICRO_INLINE double core_tr_t_ur(double t, double ur, double patm) {
+    // 1. Calcolo il titolo attuale
+    if (ur <= 0.001) return -273.15;
+    if (fabs(ur - 100.0) < 0.00001) return t;
+    double x_attuale = core_x_t_ur(t, ur, patm);
+    // 2. Cerco la temperatura che produce quel titolo con ur = 100
+    // Usando la tua funzione core_t_ur_x(ur, x, patm)
+    return core_t_ur_x(100.0, x_attuale, patm);
+}
+PSICRO_INLINE double core_tr_t_x(double t, double x, double patm) {
+    if (x <= 0.0) return -273.15;
+    if (x >= core_xsat_t(t, patm)) return t; // Saturazione
+    double ur_calc = core_ur_t_x(t, x, patm);
+    return core_tr_t_ur(t, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_t_h(double t, double h, double patm) {
+    double ur_calc = core_ur_t_h(t, h, patm);
+    return core_tr_t_ur(t, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_t_vau(double t, double vau, double patm) {
+    double ur_calc = core_ur_t_vau(t, vau, patm);
+    return core_tr_t_ur(t, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_t_tbu(double t, double tbu, double patm) {
+    if (fabs(t - tbu) <= 0.000001) return tbu; // sicurezza
+    double x = core_x_t_tbu(t, tbu, patm);
+    return core_tr_t_x(t, x, patm);
+}
+PSICRO_INLINE double core_tr_ur_x(double ur, double x, double patm) {
+    if ((x <= 0.0) || (ur <= 0.001)) return -273.15;
+    if (ur >= 100.0) return core_t_ur_x(100, x, patm); // Saturazione
+    double t_calc = core_t_ur_x(ur, x, patm);
+    double ur_calc = core_ur_t_x(t_calc, x, patm);
+    return core_tr_t_ur(t_calc, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_ur_h(double ur, double h, double patm) {
+    if (ur <= 0.001) return -273.15;
+    if (ur >= 100.0) return core_t_ur_h(100, h, patm); // Saturazione
+    double t_calc = core_t_ur_h(ur, h, patm);
+    double ur_calc = core_ur_t_h(t_calc, h, patm);
+    return core_tr_t_ur(t_calc, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_ur_vau(double ur, double vau, double patm) {
+    if (ur <= 0.001) return -273.15;
+    if (ur >= 100.0) return core_t_ur_vau(100, vau, patm); // Saturazione
+    double t_calc = core_t_ur_vau(ur, vau, patm);
+    double ur_calc = core_ur_t_vau(t_calc, vau, patm);
+    return core_tr_t_ur(t_calc, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_ur_tbu(double ur, double tbu, double patm) {
+    double t_calc = core_t_ur_tbu(ur, tbu, patm);
+    double ur_calc = core_ur_t_tbu(t_calc, tbu, patm);
+    return core_tr_t_ur(t_calc, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_x_h(double x, double h, double patm) {
+    if (x < 0.0) return -273.15;
+    double t = core_t_x_h(x, h);
+    double xsat = core_xsat_t(t, patm);
+    if (fabs(x - xsat) <= 0.000001) return core_t_ur_x(100, x, patm); // Saturazione
+    double t_calc = core_t_x_h(x, h);
+    double ur_calc = core_ur_t_x(t_calc, x, patm);
+    return core_tr_t_ur(t_calc, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_x_vau(double x, double vau, double patm) {
+    double t_calc = core_t_x_vau(x, vau, patm);
+    double ur_calc = core_ur_t_x(t_calc, x, patm);
+    return core_tr_t_ur(t_calc, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_x_tbu(double x, double tbu, double patm) {
+    double t_calc = core_t_x_tbu(x, tbu, patm);
+    if (x < 0.000001) return -273.15;
+    if (fabs(t_calc - tbu) >= 0.000001) t_calc = tbu; // sicurezza
+    return core_tr_t_x(t_calc, x, patm);
+}
+PSICRO_INLINE double core_tr_h_vau(double h, double vau, double patm) {
+    double t_calc = core_t_h_vau(h, vau, patm);
+    double ur_calc = core_ur_t_h(t_calc, h, patm);
+    return core_tr_t_ur(t_calc, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_h_tbu(double h, double tbu, double patm) {
+    double t_calc = core_t_h_tbu(h, tbu, patm);
+    double ur_calc = core_ur_t_h(t_calc, h, patm);
+    return core_tr_t_ur(t_calc, ur_calc, patm);
+}
+PSICRO_INLINE double core_tr_vau_tbu(double vau, double tbu, double patm) {
+    double t_calc = core_t_vau_tbu(vau, tbu, patm);
+    double ur_calc = core_ur_t_vau(t_calc, vau, patm);
+    return core_tr_t_ur(t_calc, ur_calc, patm);
+}
+
+
+// --- STATO (t, x) DA UNA COPPIA QUALSIASI ---
+// Solutore generico: lo stato primario è (t, x) e le due grandezze note sono
+// due equazioni in (t, x). Ogni grandezza nota diversa da t dà x come funzione
+// esplicita di t (x costante per x e tr), quindi il sistema 2x2 si riduce a
+// una sola equazione in t, F(t) = p_b(t, x_e(t)) - v_b, risolta con Newton e
+// derivata analitica dF/dt = dF/dt|x + dF/dx * dx_e/dt (lo Jacobiano ridotto).
+// Le coppie con t, x o tr, e (h, tbu), sono in forma chiusa; (x, tr) non
+// determina lo stato (x fissa tr per ogni t) e ritorna PSICRO_ERR_NON_SUPP.
+
+// x e dx/dt sul vincolo 'id = v' alla temperatura t (id = ur, h, vau o tbu)
+PSICRO_INLINE double core_x_vincolo(int id, double v, double t, double patm, double* dxdt) {
+    switch (id) {
+    case PSICRO_UR: {
+        double phi = v / 100.0;
+        double pv = phi * core_Psat(t);
+        double den = patm - pv;
+        *dxdt = RAV * phi * core_dPsat_dt(t) * patm / (den * den);
+        return RAV * pv / den;
+    }
+    case PSICRO_H: {
+        double x = (v - CPAS * t) / (LAMBDA + CPV * t);
+        *dxdt = -(CPAS + CPV * x) / (LAMBDA + CPV * t);
+        return x;
+    }
+    case PSICRO_VAU: {
+        double T = t + 273.15;
+        *dxdt = -RAV * v * patm / (RA * T * T);
+        return (v * patm / (RA * T) - 1.0) * RAV;
+    }
+    default: { // PSICRO_TBU, eq. (33) AFH 2017 risolta in x
+        double xs = core_xsat_t(v, patm);
+        double hw = core_hw_bu(v);
+        double num = core_h_t_x(v, xs) - xs * hw - CPAS * t;
+        double den = LAMBDA + CPV * t - hw;
+        double x = num / den;
+        *dxdt = -(CPAS + CPV * x) / den;
+        return x;
+    }
+    }
+}
+// Residuo della grandezza 'id = v' nello stato (t, x) e derivate parziali.
+// ur si scrive come pv(x) - phi * Psat(t) e vau moltiplicato per patm: le
+// derivate restano regolari su tutto il campo.
+PSICRO_INLINE double core_residuo_tx(int id, double v, double t, double x, double patm, double* dft, double* dfx) {
+    switch (id) {
+    case PSICRO_UR: {
+        double phi = v / 100.0;
+        *dft = -phi * core_dPsat_dt(t);
+        *dfx = patm * RAV / ((RAV + x) * (RAV + x));
+        return x * patm / (RAV + x) - phi * core_Psat(t);
+    }
+    case PSICRO_H:
+        *dft = CPAS + CPV * x;
+        *dfx = LAMBDA + CPV * t;
+        return core_h_t_x(t, x) - v;
+    default: // PSICRO_VAU
+        *dft = RA * (1.0 + x / RAV);
+        *dfx = RA * (t + 273.15) / RAV;
+        return RA * (t + 273.15) * (1.0 + x / RAV) - v * patm;
+    }
+}
+PSICRO_INLINE int core_stato_tx(int id1, double v1, int id2, double v2, double patm, double* t, double* x) {
+    if (id1 > id2) {
+        int ti = id1; id1 = id2; id2 = ti;
+        double tv = v1; v1 = v2; v2 = tv;
+    }
+    if (id1 < 0 || id2 >= PSICRO_N_PROP || id1 == id2) return PSICRO_ERR_ARG;
+    // Con t: x esplicito
+    if (id1 == PSICRO_T) {
+        core_termini_t k;
+        core_termini(id2, v1, v2, &k);
+        *t = v1;
+        *x = core_x_coppia_t(id2, v1, v2, &k, patm);
+        return PSICRO_OK;
+    }
+    // Con x o tr: x noto, t in forma chiusa dall'altra grandezza
+    if (id1 == PSICRO_X || id2 == PSICRO_X || id2 == PSICRO_TR) {
+        int id_x = (id1 == PSICRO_X) ? id1 : id2;
+        int id_o = (id_x == id1) ? id2 : id1;
+        double v_x = (id_x == id1) ? v1 : v2, v_o = (id_x == id1) ? v2 : v1;
+        if (id_o == PSICRO_X || id_o == PSICRO_TR) return PSICRO_ERR_NON_SUPP; // (x, tr)
+        double xx = (id_x == PSICRO_X) ? v_x : core_x_t_ur(v_x, 100, patm);
+        double tt;
+        switch (id_o) {
+        case PSICRO_UR:
+            if (v_o <= 0.0) return PSICRO_ERR_DATI;
+            tt = core_TPsat((xx * patm) / ((v_o / 100.0) * (RAV + xx)));
+            break;
+        case PSICRO_H: tt = core_t_x_h(xx, v_o); break;
+        case PSICRO_VAU: tt = v_o * patm / (RA * (1.0 + xx / RAV)) - 273.15; break; // Inversa esatta di vau(t, x)
+        default: tt = core_t_x_tbu(xx, v_o, patm); break;
+        }
+        *t = tt;
+        *x = xx;
+        return isfinite(tt) ? PSICRO_OK : PSICRO_ERR_DATI;
+    }
+    // (h, tbu): il bilancio di bulbo umido è lineare in x
+    if (id1 == PSICRO_H && id2 == PSICRO_TBU) {
+        double hw = core_hw_bu(v2);   // |hw| >= CPW * T_TRIPLO: il divisore non si annulla
+        double xs = core_xsat_t(v2, patm);
+        *x = xs - (core_h_t_x(v2, xs) - v1) / hw;
+        *t = core_t_x_h(*x, v1);
+        return (isfinite(*x) && isfinite(*t)) ? PSICRO_OK : PSICRO_ERR_DATI;
+    }
+    // Restanti: (ur, h), (ur, vau), (ur, tbu), (h, vau), (vau, tbu). Il vincolo
+    // che elimina x è tbu se presente (tbu(t, x) non è esplicita), altrimenti id1.
+    int e = (id2 == PSICRO_TBU) ? id2 : id1;
+    int b = (e == id1) ? id2 : id1;
+    double ve = (e == id1) ? v1 : v2, vb = (e == id1) ? v2 : v1;
+    if (e == PSICRO_UR && ve <= 0.0) {
+        // Aria secca: x = 0
+        *x = 0.0;
+        *t = (b == PSICRO_H) ? vb / CPAS : vb * patm / RA - 273.15;
+        return PSICRO_OK;
+    }
+    // Stima iniziale: t in forma chiusa dal vincolo con un titolo plausibile
+    double tt, xg;
+    if (e == PSICRO_TBU) {
+        double xs = core_xsat_t(ve, patm);
+        xg = (b == PSICRO_UR) ? (vb / 100.0) * xs : 0.5 * xs;
+        tt = core_t_x_tbu(xg, ve, patm);
+        if (b == PSICRO_VAU) {
+            double t_v = core_t_x_vau(xs, vb, patm);   // Stato saturo con lo stesso vau
+            if (t_v > tt) tt = t_v;
+        }
+    }
+    else if (b == PSICRO_H) {
+        tt = vb / (CPAS + (ve / 100.0) * 0.05 * LAMBDA);   // Come t_ur_h
+    }
+    else {
+        tt = vb * patm / RA - 273.15;                   // vau come aria secca
+        if (e == PSICRO_H) tt = core_t_x_vau(core_x_t_h(tt, ve) > 0.0 ? core_x_t_h(tt, ve) : 0.0, vb, patm);
+    }
+    // Newton salvaguardato: l'intervallo [lo, hi] si restringe con il segno di F
+    // e un passo che ne esce diventa una bisezione. Con ur il titolo ha un polo
+    // dove phi * Psat(t) = patm: oltre il polo x è negativo e diventa il nuovo hi.
+    double lo = -100.0, hi = 200.0;
+    if (!(tt > lo && tt < hi)) tt = 0.5 * (lo + hi);
+    const double eps_t = psicro_prec_attiva()->newton_eps_t_h;
+    const int max_iter = 50;
+    double passo_prec = HUGE_VAL;
+    int cresce = -1;
+    int it;
+    for (it = 0; it < max_iter; it++) {
+        double dxdt, dft, dfx;
+        double xx = core_x_vincolo(e, ve, tt, patm, &dxdt);
+        if (!(xx >= 0.0) && e == PSICRO_UR) {
+            hi = tt;
+            tt = 0.5 * (lo + hi);
+            passo_prec = HUGE_VAL;
+            continue;
+        }
+        double f = core_residuo_tx(b, vb, tt, xx, patm, &dft, &dfx);
+        double df = dft + dfx * dxdt;
+        if (f == 0.0) break;
+        if (cresce < 0) cresce = (df > 0.0);
+        if ((f > 0.0) == cresce) hi = tt;
+        else lo = tt;
+        double tn = tt - f / df;
+        if (!(tn >= lo && tn <= hi)) tn = 0.5 * (lo + hi);
+        double step = tt - tn;
+        tt = tn;
+        // Convergenza, o passo ormai al livello dell'arrotondamento che non cala più
+        if (fabs(step) < eps_t || (fabs(step) < 1e-9 && fabs(step) >= passo_prec)) break;
+        passo_prec = fabs(step);
+    }
+    double dxdt;
+    *t = tt;
+    *x = core_x_vincolo(e, ve, tt, patm, &dxdt);
+    if (it >= max_iter || !isfinite(tt) || !isfinite(*x)) {
+        psicro_ctx_conta(max_iter, PSICRO_STATO_NON_CONV);
+        return PSICRO_ERR_DATI;
+    }
+    psicro_ctx_conta(it + 1, PSICRO_STATO_OK);
+    return PSICRO_OK;
+}
+
+#endif
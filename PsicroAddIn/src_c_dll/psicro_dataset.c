@@ -0,0 +1,322 @@
+#include "psicro_dataset.h"
+#include "psicro_thread.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCCO_AGG  4096   // Righe per unità di lavoro nel ricalcolo
+
+typedef struct {
+    long long inizio, fine;      // [inizio, fine)
+} intervallo;
+
+struct psicro_dataset {
+    int id1, id2;
+    long long n, cap;
+    double* v1;
+    double* v2;
+    double* col[PSICRO_N_PROP];             // NULL se il target non è calcolato
+    unsigned char completa[PSICRO_N_PROP];  // Colonna da ricalcolare per intero
+    intervallo sporchi[PSICRO_DATASET_MAX_INTERVALLI + 1]; // Ordinati e disgiunti
+    int n_sporchi;
+    double patm_calc;            // PATM dell'ultimo aggiornamento (NaN: mai)
+    long long versione;
+    psicro_mutex mtx;            // Dati e stato: tenuto solo per copie brevi
+    psicro_mutex mtx_agg;        // Un aggiornamento alla volta
+};
+
+// --- INTERVALLI SPORCHI ---
+// Inserisce [a, b) fondendo gli intervalli sovrapposti o adiacenti; oltre il
+// limite fonde la coppia con il vuoto più piccolo (ricalcola qualche riga in più).
+static void segna_sporco(psicro_dataset* ds, long long a, long long b) {
+    if (b <= a) return;
+    intervallo* sp = ds->sporchi;
+    int i = 0;
+    while (i < ds->n_sporchi && sp[i].fine < a) i++;
+    int j = i;
+    while (j < ds->n_sporchi && sp[j].inizio <= b) {
+        if (sp[j].inizio < a) a = sp[j].inizio;
+        if (sp[j].fine > b) b = sp[j].fine;
+        j++;
+    }
+    // sp[i .. j) diventano un solo intervallo
+    memmove(&sp[i + 1], &sp[j], (size_t)(ds->n_sporchi - j) * sizeof(intervallo));
+    ds->n_sporchi += 1 - (j - i);
+    sp[i].inizio = a;
+    sp[i].fine = b;
+    if (ds->n_sporchi > PSICRO_DATASET_MAX_INTERVALLI) {
+        int k_min = 0;
+        for (int k = 1; k < ds->n_sporchi - 1; k++) {
+            if (sp[k + 1].inizio - sp[k].fine < sp[k_min + 1].inizio - sp[k_min].fine) k_min = k;
+        }
+        sp[k_min].fine = sp[k_min + 1].fine;
+        memmove(&sp[k_min + 1], &sp[k_min + 2], (size_t)(ds->n_sporchi - k_min - 2) * sizeof(intervallo));
+        ds->n_sporchi--;
+    }
+}
+
+static int cresci(psicro_dataset* ds, long long n_min) {
+    if (n_min <= ds->cap) return PSICRO_OK;
+    long long cap = (ds->cap > 0) ? ds->cap : 1024;
+    while (cap < n_min) cap *= 2;
+    double* p;
+    if (!(p = (double*)realloc(ds->v1, (size_t)cap * sizeof(double)))) return PSICRO_ERR_MEM;
+    ds->v1 = p;
+    if (!(p = (double*)realloc(ds->v2, (size_t)cap * sizeof(double)))) return PSICRO_ERR_MEM;
+    ds->v2 = p;
+    for (int t = 0; t < PSICRO_N_PROP; t++) {
+        if (!ds->col[t]) continue;
+        if (!(p = (double*)realloc(ds->col[t], (size_t)cap * sizeof(double)))) return PSICRO_ERR_MEM;
+        for (long long i = ds->cap; i < cap; i++) p[i] = NAN;
+        ds->col[t] = p;
+    }
+    ds->cap = cap;
+    return PSICRO_OK;
+}
+
+PSICRO_EXPORT psicro_dataset* PSICRO_CALL psicro_dataset_crea(int id1, int id2) {
+    if (id1 < 0 || id1 >= PSICRO_N_PROP || id2 < 0 || id2 >= PSICRO_N_PROP || id1 == id2) return NULL;
+    psicro_dataset* ds = (psicro_dataset*)calloc(1, sizeof(psicro_dataset));
+    if (!ds) return NULL;
+    ds->id1 = id1;
+    ds->id2 = id2;
+    ds->patm_calc = NAN;
+    psicro_mutex_init(&ds->mtx);
+    psicro_mutex_init(&ds->mtx_agg);
+    return ds;
+}
+
+PSICRO_EXPORT void PSICRO_CALL psicro_dataset_libera(psicro_dataset* ds) {
+    if (!ds) return;
+    for (int t = 0; t < PSICRO_N_PROP; t++) free(ds->col[t]);
+    free(ds->v1);
+    free(ds->v2);
+    psicro_mutex_destroy(&ds->mtx);
+    psicro_mutex_destroy(&ds->mtx_agg);
+    free(ds);
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_dataset_aggiungi_target(psicro_dataset* ds, int target) {
+    if (!ds || target < 0 || target >= PSICRO_N_PROP || target == ds->id1 || target == ds->id2) return PSICRO_ERR_ARG;
+    if (psicro_funzione(target, ds->id1, ds->id2) == NULL) return PSICRO_ERR_NON_SUPP;
+    int err = PSICRO_OK;
+    psicro_mutex_lock(&ds->mtx);
+    if (!ds->col[target]) {
+        long long cap = (ds->cap > 0) ? ds->cap : 1;
+        double* c = (double*)malloc((size_t)cap * sizeof(double));
+        if (c) {
+            for (long long i = 0; i < cap; i++) c[i] = NAN;
+            ds->col[target] = c;
+            ds->completa[target] = 1;
+        }
+        else {
+            err = PSICRO_ERR_MEM;
+        }
+    }
+    psicro_mutex_unlock(&ds->mtx);
+    return err;
+}
+
+PSICRO_EXPORT long long PSICRO_CALL psicro_dataset_accoda(psicro_dataset* ds, const double* v1, const double* v2, long long n) {
+    if (!ds || !v1 || !v2 || n <= 0) return PSICRO_ERR_ARG;
+    psicro_mutex_lock(&ds->mtx);
+    long long r = cresci(ds, ds->n + n);
+    if (r == PSICRO_OK) {
+        memcpy(ds->v1 + ds->n, v1, (size_t)n * sizeof(double));
+        memcpy(ds->v2 + ds->n, v2, (size_t)n * sizeof(double));
+        segna_sporco(ds, ds->n, ds->n + n);
+        ds->n += n;
+        r = ds->n;
+    }
+    psicro_mutex_unlock(&ds->mtx);
+    return r;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_dataset_modifica(psicro_dataset* ds, long long inizio,
+    const double* v1, const double* v2, long long n) {
+    if (!ds || (!v1 && !v2) || n <= 0 || inizio < 0) return PSICRO_ERR_ARG;
+    int err = PSICRO_OK;
+    psicro_mutex_lock(&ds->mtx);
+    if (inizio + n > ds->n) {
+        err = PSICRO_ERR_ARG;
+    }
+    else {
+        if (v1) memcpy(ds->v1 + inizio, v1, (size_t)n * sizeof(double));
+        if (v2) memcpy(ds->v2 + inizio, v2, (size_t)n * sizeof(double));
+        segna_sporco(ds, inizio, inizio + n);
+    }
+    psicro_mutex_unlock(&ds->mtx);
+    return err;
+}
+
+// --- RICALCOLO ---
+// Gli ingressi sporchi si copiano impacchettati in v1s/v2s: il segmento k va
+// dalla riga seg[k].inizio, lungo seg[k].fine - seg[k].inizio, alla posizione
+// off[k] delle copie. Le colonne da ricalcolare per intero (o tutte, se PATM è
+// cambiata) costringono a copiare tutte le righe; allora le altre colonne
+// ricalcolano solo gli intervalli sporchi, alla stessa posizione della riga.
+typedef struct {
+    int target;
+    long long off, m;
+} lavoro;
+
+PSICRO_EXPORT long long PSICRO_CALL psicro_dataset_aggiorna(psicro_dataset* ds) {
+    if (!ds) return PSICRO_ERR_ARG;
+    psicro_mutex_lock(&ds->mtx_agg);
+    psicro_mutex_lock(&ds->mtx);
+    const long long n = ds->n;
+    const double p = PATM;
+    const int cambio_p = (p != ds->patm_calc);
+    int n_sp = ds->n_sporchi;
+    intervallo sp[PSICRO_DATASET_MAX_INTERVALLI + 1];
+    memcpy(sp, ds->sporchi, (size_t)n_sp * sizeof(intervallo));
+    // Colonne fissate qui: una colonna aggiunta durante il calcolo resta sporca
+    int attiva[PSICRO_N_PROP], intera[PSICRO_N_PROP];
+    int tutte = 0, n_col = 0;
+    for (int t = 0; t < PSICRO_N_PROP; t++) {
+        attiva[t] = (ds->col[t] != NULL);
+        intera[t] = attiva[t] && (ds->completa[t] || cambio_p);
+        tutte |= intera[t];
+        n_col += attiva[t];
+    }
+    // Segmenti impacchettati
+    long long off[PSICRO_DATASET_MAX_INTERVALLI + 1];
+    long long m = 0;
+    if (tutte) {
+        m = n;
+    }
+    else {
+        for (int k = 0; k < n_sp; k++) {
+            off[k] = m;
+            m += sp[k].fine - sp[k].inizio;
+        }
+    }
+    if (m == 0 || n_col == 0) {
+        psicro_mutex_unlock(&ds->mtx);
+        psicro_mutex_unlock(&ds->mtx_agg);
+        return 0;
+    }
+    double* v1s = (double*)malloc((size_t)m * sizeof(double));
+    double* v2s = (double*)malloc((size_t)m * sizeof(double));
+    double* outs = (double*)malloc((size_t)m * n_col * sizeof(double));
+    long long max_lavori = n_col * ((m + BLOCCO_AGG - 1) / BLOCCO_AGG + n_sp + 1);
+    lavoro* lav = (lavoro*)malloc((size_t)max_lavori * sizeof(lavoro));
+    if (!v1s || !v2s || !outs || !lav) {
+        psicro_mutex_unlock(&ds->mtx);
+        psicro_mutex_unlock(&ds->mtx_agg);
+        free(v1s);
+        free(v2s);
+        free(outs);
+        free(lav);
+        return PSICRO_ERR_MEM;
+    }
+    if (tutte) {
+        memcpy(v1s, ds->v1, (size_t)n * sizeof(double));
+        memcpy(v2s, ds->v2, (size_t)n * sizeof(double));
+    }
+    else {
+        for (int k = 0; k < n_sp; k++) {
+            long long l = sp[k].fine - sp[k].inizio;
+            memcpy(v1s + off[k], ds->v1 + sp[k].inizio, (size_t)l * sizeof(double));
+            memcpy(v2s + off[k], ds->v2 + sp[k].inizio, (size_t)l * sizeof(double));
+        }
+    }
+    // Ciò che si è copiato è in lavorazione: le modifiche da qui in poi risultano sporche
+    ds->n_sporchi = 0;
+    for (int t = 0; t < PSICRO_N_PROP; t++) {
+        if (attiva[t]) ds->completa[t] = 0;
+    }
+    ds->patm_calc = p;
+    psicro_mutex_unlock(&ds->mtx);
+
+    // Unità di lavoro: (colonna, segmento, blocco)
+    long long n_lav = 0, celle = 0;
+    int slot[PSICRO_N_PROP];
+    int c = 0;
+    for (int t = 0; t < PSICRO_N_PROP; t++) {
+        slot[t] = -1;
+        if (!attiva[t]) continue;
+        slot[t] = c++;
+        int n_seg = intera[t] ? 1 : n_sp;
+        for (int k = 0; k < n_seg; k++) {
+            long long o = intera[t] ? 0 : (tutte ? sp[k].inizio : off[k]);
+            long long l = intera[t] ? n : sp[k].fine - sp[k].inizio;
+            celle += l;
+            for (long long i = 0; i < l; i += BLOCCO_AGG) {
+                lav[n_lav].target = t;
+                lav[n_lav].off = o + i;
+                lav[n_lav].m = (l - i < BLOCCO_AGG) ? l - i : BLOCCO_AGG;
+                n_lav++;
+            }
+        }
+    }
+#pragma omp parallel for schedule(dynamic)
+    for (long long w = 0; w < n_lav; w++) {
+        const lavoro* L = &lav[w];
+        psicro_batch_blocco(L->target, ds->id1, v1s + L->off, ds->id2, v2s + L->off, L->m, p,
+            outs + (long long)slot[L->target] * m + L->off);
+    }
+
+    // Pubblicazione: le righe < n esistono ancora (le righe non si eliminano)
+    psicro_mutex_lock(&ds->mtx);
+    for (long long w = 0; w < n_lav; w++) {
+        const lavoro* L = &lav[w];
+        long long riga = L->off;
+        if (!tutte) {
+            // Posizione impacchettata -> riga
+            int k = 0;
+            while (k + 1 < n_sp && off[k + 1] <= L->off) k++;
+            riga = sp[k].inizio + (L->off - off[k]);
+        }
+        memcpy(ds->col[L->target] + riga, outs + (long long)slot[L->target] * m + L->off, (size_t)L->m * sizeof(double));
+    }
+    ds->versione++;
+    psicro_mutex_unlock(&ds->mtx);
+    psicro_mutex_unlock(&ds->mtx_agg);
+    free(v1s);
+    free(v2s);
+    free(outs);
+    free(lav);
+    return celle;
+}
+
+PSICRO_EXPORT long long PSICRO_CALL psicro_dataset_leggi(psicro_dataset* ds, int target, long long inizio,
+    long long n, double* out, long long* versione) {
+    if (!ds || !out || n <= 0 || inizio < 0 || target < 0 || target >= PSICRO_N_PROP) return PSICRO_ERR_ARG;
+    long long r;
+    psicro_mutex_lock(&ds->mtx);
+    const double* src = (target == ds->id1) ? ds->v1 : (target == ds->id2) ? ds->v2 : ds->col[target];
+    if (!src) {
+        r = PSICRO_ERR_NON_SUPP;
+    }
+    else {
+        r = (inizio >= ds->n) ? 0 : ((inizio + n > ds->n) ? ds->n - inizio : n);
+        if (r > 0) memcpy(out, src + inizio, (size_t)r * sizeof(double));
+    }
+    if (versione) *versione = ds->versione;
+    psicro_mutex_unlock(&ds->mtx);
+    return r;
+}
+
+PSICRO_EXPORT long long PSICRO_CALL psicro_dataset_righe(psicro_dataset* ds) {
+    if (!ds) return PSICRO_ERR_ARG;
+    psicro_mutex_lock(&ds->mtx);
+    long long n = ds->n;
+    psicro_mutex_unlock(&ds->mtx);
+    return n;
+}
+
+PSICRO_EXPORT long long PSICRO_CALL psicro_dataset_sporche(psicro_dataset* ds) {
+    if (!ds) return PSICRO_ERR_ARG;
+    psicro_mutex_lock(&ds->mtx);
+    long long s = 0;
+    int cambio_p = (PATM != ds->patm_calc);
+    for (int t = 0; t < PSICRO_N_PROP; t++) {
+        if (ds->col[t] && (ds->completa[t] || cambio_p)) s = ds->n;
+    }
+    if (s == 0) {
+        for (int k = 0; k < ds->n_sporchi; k++) s += ds->sporchi[k].fine - ds->sporchi[k].inizio;
+    }
+    psicro_mutex_unlock(&ds->mtx);
+    return s;
+}
@@ -0,0 +1,41 @@
+#ifndef PSICRO_DATASET_H
+#define PSICRO_DATASET_H
+
+#include "psicrometria.h"
+
+// --- DATASET CON RICALCOLO INCREMENTALE ---
+// Il dataset possiede le due colonne di ingresso (id1, id2) e le colonne
+// calcolate (una per target). Accodamenti e correzioni segnano sporchi solo
+// gli intervalli di righe toccati; una nuova colonna target è sporca per
+// intero; se PATM cambia rispetto all'ultimo aggiornamento (versione di
+// pressione) è sporco tutto. psicro_dataset_aggiorna ricalcola solo questo.
+//
+// Lettori concorrenti: il calcolo avviene su copie, fuori dal lock; il lock
+// si tiene solo per copiare gli ingressi sporchi e per pubblicare i risultati.
+// Chi legge durante un aggiornamento vede i valori precedenti (NaN per righe
+// mai calcolate) e mai una colonna a metà scrittura di un blocco; la versione
+// restituita da psicro_dataset_leggi cambia a ogni pubblicazione.
+#define PSICRO_DATASET_MAX_INTERVALLI  256  // Oltre si fondono gli intervalli più vicini
+
+typedef struct psicro_dataset psicro_dataset;
+
+PSICRO_EXPORT psicro_dataset* PSICRO_CALL psicro_dataset_crea(int id1, int id2);
+PSICRO_EXPORT void PSICRO_CALL psicro_dataset_libera(psicro_dataset* ds);
+// Aggiunge la colonna calcolata 'target' (già presente: nessun effetto)
+PSICRO_EXPORT int PSICRO_CALL psicro_dataset_aggiungi_target(psicro_dataset* ds, int target);
+// Accoda n righe; ritorna il numero di righe totali o un PSICRO_ERR_*
+PSICRO_EXPORT long long PSICRO_CALL psicro_dataset_accoda(psicro_dataset* ds, const double* v1, const double* v2, long long n);
+// Sovrascrive le righe [inizio, inizio + n); v1 o v2 NULL lascia invariata quella colonna
+PSICRO_EXPORT int PSICRO_CALL psicro_dataset_modifica(psicro_dataset* ds, long long inizio,
+	const double* v1, const double* v2, long long n);
+// Ricalcola le righe sporche; ritorna le celle (riga, colonna) ricalcolate o un PSICRO_ERR_*
+PSICRO_EXPORT long long PSICRO_CALL psicro_dataset_aggiorna(psicro_dataset* ds);
+// Copia le righe [inizio, inizio + n) della colonna target (anche id1/id2) in out;
+// ritorna le righe copiate o un PSICRO_ERR_*. versione (opz.): pubblicazioni finora
+PSICRO_EXPORT long long PSICRO_CALL psicro_dataset_leggi(psicro_dataset* ds, int target, long long inizio,
+	long long n, double* out, long long* versione);
+PSICRO_EXPORT long long PSICRO_CALL psicro_dataset_righe(psicro_dataset* ds);
+// Righe sporche in attesa di aggiornamento (per la colonna più indietro)
+PSICRO_EXPORT long long PSICRO_CALL psicro_dataset_sporche(psicro_dataset* ds);
+
+#endif
@@ -0,0 +1,237 @@
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicro_design.h"
+#include "psicro_core.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- ISTOGRAMMA A CLASSI FISSE (mergeable) ---
+// Ogni classe conta i campioni e somma fino a due grandezze coincidenti.
+// I valori fuori campo finiscono nella prima/ultima classe.
+typedef struct {
+    double lo, passo;
+    int n;
+    long long tot;
+    long long* conta;
+    double* c1;
+    double* c2;
+} istogramma;
+
+static int ist_init(istogramma* ist, double lo, double hi, double passo, int n_coinc) {
+    memset(ist, 0, sizeof(*ist));
+    ist->lo = lo;
+    ist->passo = passo;
+    // Numero di classi verificato in double: ±inf o un campo troppo largo non arrivano al cast
+    const double n = ceil((hi - lo) / passo);
+    if (!(n >= 1.0 && n <= PSICRO_DESIGN_MAX_CLASSI)) return PSICRO_ERR_ARG;
+    ist->n = (int)n;
+    ist->conta = (long long*)calloc(ist->n, sizeof(long long));
+    if (n_coinc >= 1) ist->c1 = (double*)calloc(ist->n, sizeof(double));
+    if (n_coinc >= 2) ist->c2 = (double*)calloc(ist->n, sizeof(double));
+    if (!ist->conta || (n_coinc >= 1 && !ist->c1) || (n_coinc >= 2 && !ist->c2)) return PSICRO_ERR_MEM;
+    return PSICRO_OK;
+}
+static void ist_free(istogramma* ist) {
+    free(ist->conta);
+    free(ist->c1);
+    free(ist->c2);
+    memset(ist, 0, sizeof(*ist));
+}
+static int ist_classe(const istogramma* ist, double v) {
+    const double k = floor((v - ist->lo) / ist->passo);
+    if (!(k >= 0.0)) return 0;   // Anche NaN
+    if (k >= ist->n) return ist->n - 1;
+    return (int)k;
+}
+static void ist_add(istogramma* ist, double v, double a, double b) {
+    int k = ist_classe(ist, v);
+    ist->conta[k]++;
+    ist->tot++;
+    if (ist->c1) ist->c1[k] += a;
+    if (ist->c2) ist->c2[k] += b;
+}
+static void ist_merge(istogramma* dst, const istogramma* src) {
+    for (int k = 0; k < dst->n; k++) {
+        dst->conta[k] += src->conta[k];
+        if (dst->c1) dst->c1[k] += src->c1[k];
+        if (dst->c2) dst->c2[k] += src->c2[k];
+    }
+    dst->tot += src->tot;
+}
+// Valore superato per il 'perc' % dei campioni (interpolato nella classe)
+static double ist_superamento(const istogramma* ist, double perc) {
+    if (ist->tot == 0) return NAN;
+    double rango = (1.0 - perc / 100.0) * (double)ist->tot;
+    long long cum = 0;
+    for (int k = 0; k < ist->n; k++) {
+        if (ist->conta[k] == 0) continue;
+        if ((double)(cum + ist->conta[k]) >= rango) {
+            double f = (rango - (double)cum) / (double)ist->conta[k];
+            if (f < 0.0) f = 0.0;
+            return ist->lo + ist->passo * (k + f);
+        }
+        cum += ist->conta[k];
+    }
+    return ist->lo + ist->passo * ist->n;
+}
+// Media della grandezza coincidente sulle classi entro +/- banda da v
+static double ist_media_coinc(const istogramma* ist, const double* somme, double v, double banda) {
+    int k0 = ist_classe(ist, v - banda);
+    int k1 = ist_classe(ist, v + banda);
+    long long cnt = 0;
+    double s = 0.0;
+    for (int k = k0; k <= k1; k++) {
+        cnt += ist->conta[k];
+        s += somme[k];
+    }
+    return (cnt > 0) ? s / (double)cnt : NAN;
+}
+
+// --- ACCUMULATORE DELLE CONDIZIONI DI PROGETTO ---
+#define T_LO   -100.0
+#define T_HI     80.0
+#define H_LO   -100.0
+#define H_HI    300.0
+
+typedef struct {
+    istogramma tdb;   // coinc: tbu
+    istogramma twb;   // coinc: t
+    istogramma tdp;   // coinc: x, t
+    istogramma h;     // coinc: t
+} design_acc;
+
+static void acc_free(design_acc* a) {
+    ist_free(&a->tdb);
+    ist_free(&a->twb);
+    ist_free(&a->tdp);
+    ist_free(&a->h);
+}
+static int acc_init(design_acc* a) {
+    memset(a, 0, sizeof(*a));
+    if (ist_init(&a->tdb, T_LO, T_HI, PSICRO_DESIGN_PASSO, 1) != PSICRO_OK ||
+        ist_init(&a->twb, T_LO, T_HI, PSICRO_DESIGN_PASSO, 1) != PSICRO_OK ||
+        ist_init(&a->tdp, T_LO, T_HI, PSICRO_DESIGN_PASSO, 2) != PSICRO_OK ||
+        ist_init(&a->h, H_LO, H_HI, PSICRO_DESIGN_PASSO, 1) != PSICRO_OK) {
+        acc_free(a);
+        return PSICRO_ERR_MEM;
+    }
+    return PSICRO_OK;
+}
+static void acc_merge(design_acc* dst, const design_acc* src) {
+    ist_merge(&dst->tdb, &src->tdb);
+    ist_merge(&dst->twb, &src->twb);
+    ist_merge(&dst->tdp, &src->tdp);
+    ist_merge(&dst->h, &src->h);
+}
+static void acc_riga(design_acc* a, double t, double ur, double p) {
+    double x = core_x_t_ur(t, ur, p);
+    double h = core_h_t_x(t, x);
+    int sat = (fabs(ur - 100.0) < 0.00001);
+    double tbu = sat ? t : core_tbu_x_h(x, h, p);
+    double tr = sat ? t : core_tr_x(x, p);
+    ist_add(&a->tdb, t, tbu, 0.0);
+    if (tbu > -273.15) ist_add(&a->twb, tbu, t, 0.0); // -999: bisezione fallita
+    if (tr > -273.15) ist_add(&a->tdp, tr, x, t);      // aria secca esclusa
+    ist_add(&a->h, h, t, 0.0);
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_design_conditions(const double* t, const double* ur, const double* patm,
+    long long n, const double* perc, int n_perc, double banda, psicro_design_out* out) {
+    if (!t || !ur || !perc || !out || n <= 0 || n_perc <= 0 || n_perc > PSICRO_DESIGN_MAX_PERC) return PSICRO_ERR_ARG;
+    if (banda <= 0.0) banda = 0.5;
+    const double p_glob = PATM;
+    design_acc tot;
+    if (acc_init(&tot) != PSICRO_OK) return PSICRO_ERR_MEM;
+    int err = PSICRO_OK;
+
+    // Una passata: ogni thread riempie i propri istogrammi, poi si fondono
+#pragma omp parallel
+    {
+        design_acc loc;
+        int ok = (acc_init(&loc) == PSICRO_OK);
+        if (!ok) {
+#pragma omp critical(psicro_design_err)
+            err = PSICRO_ERR_MEM;
+        }
+#pragma omp for schedule(static)
+        for (long long i = 0; i < n; i++) {
+            if (!ok) continue;
+            double p = patm ? patm[i] : p_glob;
+            if (isnan(t[i]) || isnan(ur[i]) || !(p > 0.0)) continue;
+            acc_riga(&loc, t[i], ur[i], p);
+        }
+        if (ok) {
+#pragma omp critical(psicro_design_merge)
+            acc_merge(&tot, &loc);
+        }
+        acc_free(&loc);
+    }
+    if (err != PSICRO_OK) {
+        acc_free(&tot);
+        return err;
+    }
+    if (tot.tdb.tot == 0) {
+        acc_free(&tot);
+        return PSICRO_ERR_DATI;
+    }
+
+    out->n_perc = n_perc;
+    out->n_validi = tot.tdb.tot;
+    for (int k = 0; k < n_perc; k++) {
+        double p = perc[k];
+        out->perc[k] = p;
+        out->tdb[k] = ist_superamento(&tot.tdb, p);
+        out->mcwb[k] = ist_media_coinc(&tot.tdb, tot.tdb.c1, out->tdb[k], banda);
+        out->twb[k] = ist_superamento(&tot.twb, p);
+        out->mcdb_wb[k] = ist_media_coinc(&tot.twb, tot.twb.c1, out->twb[k], banda);
+        out->tdp[k] = ist_superamento(&tot.tdp, p);
+        out->hr_dp[k] = ist_media_coinc(&tot.tdp, tot.tdp.c1, out->tdp[k], banda);
+        out->mcdb_dp[k] = ist_media_coinc(&tot.tdp, tot.tdp.c2, out->tdp[k], banda);
+        out->h[k] = ist_superamento(&tot.h, p);
+        out->mcdb_h[k] = ist_media_coinc(&tot.h, tot.h.c1, out->h[k], banda);
+    }
+    acc_free(&tot);
+    return PSICRO_OK;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_percentili(const double* valori, const double* coinc, long long n,
+    double lo, double hi, const double* perc, int n_perc, double banda, double* out_val, double* out_coinc) {
+    if (!valori || !perc || !out_val || n <= 0 || n_perc <= 0 || !(hi > lo)) return PSICRO_ERR_ARG;
+    if (banda <= 0.0) banda = 0.5;
+    int n_coinc = coinc ? 1 : 0;
+    istogramma tot;
+    int rc = ist_init(&tot, lo, hi, PSICRO_DESIGN_PASSO, n_coinc);
+    if (rc != PSICRO_OK) {
+        ist_free(&tot);
+        return rc;
+    }
+    int err = PSICRO_OK;
+#pragma omp parallel
+    {
+        istogramma loc;
+        int ok = (ist_init(&loc, lo, hi, PSICRO_DESIGN_PASSO, n_coinc) == PSICRO_OK);
+        if (!ok) {
+#pragma omp critical(psicro_design_err)
+            err = PSICRO_ERR_MEM;
+        }
+#pragma omp for schedule(static)
+        for (long long i = 0; i < n; i++) {
+            if (!ok || isnan(valori[i]) || (coinc && isnan(coinc[i]))) continue;
+            ist_add(&loc, valori[i], coinc ? coinc[i] : 0.0, 0.0);
+        }
+        if (ok) {
+#pragma omp critical(psicro_design_merge)
+            ist_merge(&tot, &loc);
+        }
+        ist_free(&loc);
+    }
+    if (err == PSICRO_OK && tot.tot == 0) err = PSICRO_ERR_DATI;
+    if (err == PSICRO_OK) {
+        for (int k = 0; k < n_perc; k++) {
+            out_val[k] = ist_superamento(&tot, perc[k]);
+            if (out_coinc) out_coinc[k] = coinc ? ist_media_coinc(&tot, tot.c1, out_val[k], banda) : NAN;
+        }
+    }
+    ist_free(&tot);
+    return err;
+}
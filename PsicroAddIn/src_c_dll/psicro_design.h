@@ -0,0 +1,45 @@
+#ifndef PSICRO_DESIGN_H
+#define PSICRO_DESIGN_H
+
+#include "psicrometria.h"
+
+// --- CONDIZIONI DI PROGETTO (percentili stile ASHRAE) ---
+// I percentili si calcolano in una sola passata accumulando istogrammi a classi
+// fisse (uno per thread, poi fusi): la risoluzione è la larghezza di classe
+// PSICRO_DESIGN_PASSO, con interpolazione lineare all'interno della classe.
+// Nella stessa passata si sommano le grandezze coincidenti per classe, così le
+// medie coincidenti costano una lettura dell'istogramma.
+
+#define PSICRO_DESIGN_MAX_PERC  8
+#define PSICRO_DESIGN_PASSO     0.01   // Larghezza di classe [°C] o [kJ/kg]
+#define PSICRO_DESIGN_MAX_CLASSI 10000000 // (hi - lo) / PSICRO_DESIGN_PASSO massimo di psicro_percentili
+
+typedef struct {
+	int n_perc;                              // Numero di percentili richiesti
+	double perc[PSICRO_DESIGN_MAX_PERC];     // Percentuale di superamento annua (es. 0.4, 1, 2, 99.6)
+	double tdb[PSICRO_DESIGN_MAX_PERC];      // Bulbo secco di progetto [°C]
+	double mcwb[PSICRO_DESIGN_MAX_PERC];     //   bulbo umido medio coincidente [°C]
+	double twb[PSICRO_DESIGN_MAX_PERC];      // Bulbo umido di progetto [°C]
+	double mcdb_wb[PSICRO_DESIGN_MAX_PERC];  //   bulbo secco medio coincidente [°C]
+	double tdp[PSICRO_DESIGN_MAX_PERC];      // Punto di rugiada di progetto [°C]
+	double hr_dp[PSICRO_DESIGN_MAX_PERC];    //   titolo coincidente [kg/kg]
+	double mcdb_dp[PSICRO_DESIGN_MAX_PERC];  //   bulbo secco medio coincidente [°C]
+	double h[PSICRO_DESIGN_MAX_PERC];        // Entalpia di progetto [kJ/kg]
+	double mcdb_h[PSICRO_DESIGN_MAX_PERC];   //   bulbo secco medio coincidente [°C]
+	long long n_validi;                      // Righe utilizzate (scartate quelle con NaN)
+} psicro_design_out;
+
+// Condizioni di progetto da serie (t, ur). patm: pressione di stazione per riga
+// [kPa] oppure NULL per usare PATM. banda: semiampiezza [°C / kJ/kg] attorno al
+// valore di progetto su cui mediare le grandezze coincidenti (<= 0 -> 0.5).
+PSICRO_EXPORT int PSICRO_CALL psicro_design_conditions(const double* t, const double* ur, const double* patm,
+	long long n, const double* perc, int n_perc, double banda, psicro_design_out* out);
+
+// Percentili generici di una colonna già calcolata (es. uscite tbu_t_*, tr_t_*, h_t_*).
+// coinc (opzionale) è la colonna di cui si vuole la media coincidente; lo/hi
+// delimitano il campo dell'istogramma (finiti, al più PSICRO_DESIGN_MAX_CLASSI
+// classi, altrimenti PSICRO_ERR_ARG). out_coinc può essere NULL.
+PSICRO_EXPORT int PSICRO_CALL psicro_percentili(const double* valori, const double* coinc, long long n,
+	double lo, double hi, const double* perc, int n_perc, double banda, double* out_val, double* out_coinc);
+
+#endif
@@ -0,0 +1,78 @@
+#include "psicrometria.h"
+#include "psicro_core.h"
+#include "psicro_tabella.h"
+#include "psicro_trace.h"
+#include <stddef.h>
+
+// --- SELEZIONE DELLA FUNZIONE PER INDICI ---
+// Stessa logica di EseguiSwitchCalcolo in Class1.cs: la coppia si ordina con
+// l'indice minore per primo e si cerca la funzione target_a_b corrispondente.
+typedef struct {
+    int target, id1, id2;
+    psicro_fn fn;
+    psicro_fn_p fn_p;
+} voce_tabella;
+
+// Adattatori a pressione esplicita: stesso nucleo delle funzioni scalari di
+// psicrometria.c con patm al posto di PATM, risultato identico a PATM = patm.
+// Come le funzioni esportate azzerano lo stato del thread a ogni chiamata.
+#define NUCLEO_P(nome) static double nome##_p(double a, double b, double patm) { \
+    psicro_ctx_avvia(); return core_##nome(a, b, patm); }
+#define NUCLEO(nome) static double nome##_p(double a, double b, double patm) { \
+    (void)patm; psicro_ctx_avvia(); return core_##nome(a, b); }
+#define ADATTATORE(target, id1, id2, nome, nucleo) nucleo(nome)
+PSICRO_TABELLA(ADATTATORE)
+
+#define RIGA(target, id1, id2, nome, nucleo) { target, id1, id2, nome, nome##_p },
+static const voce_tabella tabella[] = {
+    PSICRO_TABELLA(RIGA)
+};
+
+psicro_fn psicro_funzione(int target, int id1, int id2) {
+    if (id1 > id2) {
+        int tmp = id1;
+        id1 = id2;
+        id2 = tmp;
+    }
+    for (size_t i = 0; i < sizeof(tabella) / sizeof(tabella[0]); i++) {
+        if (tabella[i].target == target && tabella[i].id1 == id1 && tabella[i].id2 == id2) return tabella[i].fn;
+    }
+    return NULL;
+}
+
+psicro_fn_p psicro_funzione_p(int target, int id1, int id2) {
+    if (id1 > id2) {
+        int tmp = id1;
+        id1 = id2;
+        id2 = tmp;
+    }
+    for (size_t i = 0; i < sizeof(tabella) / sizeof(tabella[0]); i++) {
+        if (tabella[i].target == target && tabella[i].id1 == id1 && tabella[i].id2 == id2) return tabella[i].fn_p;
+    }
+    return NULL;
+}
+
+PSICRO_API psicro_calc(int target, int id1, double v1, int id2, double v2) {
+    if (target == id1) return v1;
+    if (target == id2) return v2;
+    psicro_fn fn = psicro_funzione(target, id1, id2);
+    if (fn == NULL) return NAN;
+    PSICRO_TRACCIA(psicro_calc, (id1 < id2) ? fn(v1, v2) : fn(v2, v1));
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_stato_tx(int id1, double v1, int id2, double v2, double* t, double* x) {
+    if (!t || !x) return PSICRO_ERR_ARG;
+    psicro_ctx_avvia();
+    return core_stato_tx(id1, v1, id2, v2, PATM, t, x);
+}
+
+PSICRO_API psicro_calc_tx(int target, int id1, double v1, int id2, double v2) {
+    if (target < 0 || target >= PSICRO_N_PROP) return NAN;
+    if (target == id1) return v1;
+    if (target == id2) return v2;
+    const double p = PATM;
+    double t, x;
+    psicro_ctx_avvia();
+    if (core_stato_tx(id1, v1, id2, v2, p, &t, &x) != PSICRO_OK) return NAN;
+    return core_target_t_x(target, t, x, core_Psat(t), p);
+}
@@ -0,0 +1,130 @@
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicro_economizzatore.h"
+#include "psicro_core.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Grandezze orarie comuni a tutti i casi di un sito
+typedef struct {
+    double t_e, h_e, tr_e, tbu_e;   // Stato esterno (t_e NaN: ora non valida)
+    double t0;                      // Miscela alla frazione minima di aria esterna
+    double c0;                      // m * cp umido della miscela [kW/K]
+    double q_min;                   // Batteria fredda con aria esterna minima [kW]
+    double q_ae;                    // Batteria fredda con tutta aria esterna [kW]
+} eco_ora;
+
+PSICRO_EXPORT int PSICRO_CALL psicro_economizzatore(int id2, const double* t_est, const double* v2, long long n_passi,
+    int n_siti, double passo_ore, const psicro_eco_impianto* imp, const psicro_eco_caso* casi, int n_casi,
+    psicro_eco_risultato* ris, unsigned char* modi) {
+    if (!t_est || !v2 || !imp || !casi || !ris || n_passi <= 0 || n_siti <= 0 || n_casi <= 0) return PSICRO_ERR_ARG;
+    if (id2 < PSICRO_UR || id2 > PSICRO_TR) return PSICRO_ERR_NON_SUPP;
+    int serve_tr = 0, serve_tbu = 0;
+    for (int c = 0; c < n_casi; c++) {
+        if (casi[c].strategia < PSICRO_ECO_BULBO_SECCO || casi[c].strategia > PSICRO_ECO_EVAP_INDIRETTO) return PSICRO_ERR_ARG;
+        if (casi[c].strategia == PSICRO_ECO_TR_LIMITE) serve_tr = 1;
+        if (casi[c].strategia == PSICRO_ECO_EVAP_INDIRETTO) serve_tbu = 1;
+    }
+    if (passo_ore <= 0.0) passo_ore = 1.0;
+    const double patm = PATM;
+    const double f = (imp->frazione_min < 0.0) ? 0.0 : ((imp->frazione_min > 1.0) ? 1.0 : imp->frazione_min);
+    const double m = imp->portata;
+    const double t_m = imp->t_mandata;
+    const double xs_m = core_xsat_t(t_m, patm);
+    const double x_r = core_x_t_ur(imp->t_ripresa, imp->ur_ripresa, patm);
+    const double h_r = core_h_t_x(imp->t_ripresa, x_r);
+    const long long n_tot = (long long)n_siti * n_passi;
+
+    eco_ora* ore = (eco_ora*)malloc((size_t)n_tot * sizeof(eco_ora));
+    if (ore == NULL) return PSICRO_ERR_MEM;
+
+    // 1. Stato esterno e carichi indipendenti dal caso: una volta per ora e sito
+#pragma omp parallel for schedule(static)
+    for (long long i = 0; i < n_tot; i++) {
+        eco_ora* o = &ore[i];
+        const double te = t_est[i];
+        core_termini_t k;
+        core_termini(id2, te, v2[i], &k);
+        const double xe = core_x_coppia_t(id2, te, v2[i], &k, patm);
+        if (!(xe >= 0.0) || !isfinite(te) || !isfinite(xe)) {
+            o->t_e = NAN;
+            continue;
+        }
+        o->t_e = te;
+        o->h_e = core_h_t_x(te, xe);
+        o->tr_e = !serve_tr ? NAN : ((id2 == PSICRO_TR) ? v2[i] : core_tr_x(xe, patm));
+        o->tbu_e = !serve_tbu ? NAN : ((id2 == PSICRO_TBU) ? v2[i] : core_tbu_x_h(xe, o->h_e, patm));
+        const double x0 = f * xe + (1.0 - f) * x_r;
+        const double h0 = f * o->h_e + (1.0 - f) * h_r;
+        o->t0 = core_t_x_h(x0, h0);
+        o->c0 = m * (CPAS + x0 * CPV);
+        o->q_min = m * (h0 - core_h_t_x(t_m, (x0 < xs_m) ? x0 : xs_m));
+        o->q_ae = m * (o->h_e - core_h_t_x(t_m, (xe < xs_m) ? xe : xs_m));
+    }
+
+    // 2. Matrice siti x casi: solo confronti e somme sopra le grandezze orarie
+    const long long n_ris = (long long)n_siti * n_casi;
+#pragma omp parallel for schedule(dynamic)
+    for (long long j = 0; j < n_ris; j++) {
+        const long long s = j / n_casi;
+        const psicro_eco_caso* cs = &casi[j % n_casi];
+        const eco_ora* os = ore + s * n_passi;
+        unsigned char* md = modi ? modi + j * n_passi : NULL;
+        psicro_eco_risultato r;
+        memset(&r, 0, sizeof(r));
+        int modo_prec = -1;
+        for (long long i = 0; i < n_passi; i++) {
+            const eco_ora* o = &os[i];
+            if (isnan(o->t_e)) {
+                if (md) md[i] = PSICRO_ECO_NESSUNO;
+                continue;
+            }
+            int modo;
+            double q;
+            if (cs->strategia == PSICRO_ECO_EVAP_INDIRETTO) {
+                if (o->tbu_e < o->t0) {
+                    const double dt = cs->limite * (o->t0 - o->tbu_e);
+                    modo = (o->t0 - dt <= t_m) ? PSICRO_ECO_LIBERO : PSICRO_ECO_PARZIALE;
+                    q = (modo == PSICRO_ECO_LIBERO) ? 0.0 : o->q_min - o->c0 * dt;
+                }
+                else {
+                    modo = PSICRO_ECO_MECCANICO;
+                    q = o->q_min;
+                }
+            }
+            else {
+                int abilitato;
+                switch (cs->strategia) {
+                case PSICRO_ECO_BULBO_SECCO:   abilitato = (o->t_e < cs->limite); break;
+                case PSICRO_ECO_ENTALPIA_DIFF: abilitato = (o->h_e < h_r - cs->limite); break;
+                default:                       abilitato = (o->t_e < cs->limite && o->tr_e < cs->limite_tr); break;
+                }
+                if (!abilitato) {
+                    modo = PSICRO_ECO_MECCANICO;
+                    q = o->q_min;
+                }
+                else if (o->t_e <= t_m) {
+                    modo = PSICRO_ECO_LIBERO;
+                    q = 0.0;
+                }
+                else {
+                    modo = PSICRO_ECO_PARZIALE;
+                    q = o->q_ae;
+                }
+            }
+            if (q < 0.0) q = 0.0;
+            if (md) md[i] = (unsigned char)modo;
+            if (modo_prec >= 0 && modo != modo_prec) r.commutazioni++;
+            modo_prec = modo;
+            if (modo == PSICRO_ECO_LIBERO) r.ore_libero += passo_ore;
+            else if (modo == PSICRO_ECO_PARZIALE) r.ore_parziale += passo_ore;
+            else r.ore_meccanico += passo_ore;
+            r.energia_mecc += q;
+            if (q > r.picco_mecc) r.picco_mecc = q;
+        }
+        // Potenze [kW] * durata del passo [h] -> energia [kWh]
+        r.energia_mecc *= passo_ore;
+        ris[j] = r;
+    }
+    free(ore);
+    return PSICRO_OK;
+}
@@ -0,0 +1,66 @@
+#ifndef PSICRO_ECONOMIZZATORE_H
+#define PSICRO_ECONOMIZZATORE_H
+
+#include "psicrometria.h"
+
+// --- CONFRONTO DI STRATEGIE DI ECONOMIZZATORE (FREE COOLING) ---
+// Una UTA a portata costante porta l'aria a t_mandata. Per ogni ora e per ogni
+// sito lo stato esterno (x, h, tr, tbu) e i carichi della batteria fredda con
+// aria esterna minima e con tutta aria esterna si calcolano una volta; la
+// matrice di casi (strategia x limite) si valuta poi sopra questi valori con
+// soli confronti. Siti e casi si elaborano in parallelo.
+//
+// Modello, con m0 = miscela ripresa / esterna alla frazione minima:
+//   economizzatore non abilitato -> MECCANICO, batteria su m0
+//   abilitato e t_e <= t_mandata  -> LIBERO, serranda modulata, carico nullo
+//   abilitato e t_e >  t_mandata  -> PARZIALE, batteria su tutta aria esterna
+// Evaporativo indiretto: m0 si preraffredda in uno scambiatore il cui lato
+// secondario è aria esterna umidificata, t = t0 - eff (t0 - tbu_e), con x
+// invariato; LIBERO se arriva a t_mandata, altrimenti PARZIALE.
+// La batteria porta l'aria a t_mandata con x = min(x_ingresso, xsat(t_mandata));
+// il riscaldamento non si conta (carico meccanico >= 0).
+
+// Strategie (psicro_eco_caso.strategia)
+#define PSICRO_ECO_BULBO_SECCO     0   // Abilitato se t_e < limite [°C]
+#define PSICRO_ECO_ENTALPIA_DIFF   1   // Abilitato se h_e < h_ripresa - limite [kJ/kg]
+#define PSICRO_ECO_TR_LIMITE       2   // Abilitato se t_e < limite [°C] e tr_e < limite_tr [°C]
+#define PSICRO_ECO_EVAP_INDIRETTO  3   // limite = efficienza di bulbo umido [0..1]; abilitato se tbu_e < t0
+
+// Modi di funzionamento (uscita oraria)
+#define PSICRO_ECO_MECCANICO       0
+#define PSICRO_ECO_PARZIALE        1
+#define PSICRO_ECO_LIBERO          2
+#define PSICRO_ECO_NESSUNO       255   // Ora con dati esterni non validi
+
+typedef struct {
+	double t_ripresa, ur_ripresa;   // Aria di ripresa [°C], [%]
+	double t_mandata;               // Temperatura di mandata [°C]
+	double portata;                 // Portata di aria secca [kg/s]
+	double frazione_min;            // Frazione minima di aria esterna [0..1]
+} psicro_eco_impianto;
+
+typedef struct {
+	int strategia;
+	double limite;
+	double limite_tr;               // Solo PSICRO_ECO_TR_LIMITE
+} psicro_eco_caso;
+
+typedef struct {
+	double ore_libero;              // Ore di free cooling totale
+	double ore_parziale;            // Ore di economizzatore con integrazione meccanica
+	double ore_meccanico;           // Ore con economizzatore escluso
+	double energia_mecc;            // Energia della batteria fredda [kWh]
+	double picco_mecc;              // Potenza di picco della batteria fredda [kW]
+	long long commutazioni;         // Cambi di modo tra ore valide consecutive
+} psicro_eco_risultato;
+
+// id2, t_est, v2: serie esterne (t e una seconda grandezza), n_siti * n_passi
+//                 valori disposti [sito][passo]
+// passo_ore:      durata di un passo [h] (<= 0 -> 1)
+// ris:            n_siti * n_casi riepiloghi disposti [sito][caso]
+// modi:           (opz.) n_siti * n_casi * n_passi modi disposti [sito][caso][passo]
+PSICRO_EXPORT int PSICRO_CALL psicro_economizzatore(int id2, const double* t_est, const double* v2, long long n_passi,
+	int n_siti, double passo_ore, const psicro_eco_impianto* imp, const psicro_eco_caso* casi, int n_casi,
+	psicro_eco_risultato* ris, unsigned char* modi);
+
+#endif
@@ -0,0 +1,159 @@
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicro_grid.h"
+#include "psicro_core.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TJ PSICRO_GRID_TILE_J
+
+// Titolo per un tratto di riga. tb: t, pb: Psat(t), vb: seconda grandezza,
+// ab/bb: termini precalcolati per l'asse della seconda grandezza.
+static void riga_x(int idv, int m, const double* tb, const double* pb, const double* vb,
+    const double* ab, const double* bb, double p, double* xb) {
+    int j;
+    switch (idv) {
+    case PSICRO_UR:
+        for (j = 0; j < m; j++) {
+            double pv = (vb[j] / 100.0) * pb[j];
+            double xs = (pb[j] >= p) ? 9.999 : (RAV * pb[j]) / (p - pb[j]);
+            double x = (RAV * pv) / (p - pv);
+            x = (fabs(vb[j] - 100) < 0.000001) ? xs : x;
+            xb[j] = (vb[j] < 0.000001) ? 0.0 : x;
+        }
+        break;
+    case PSICRO_X:
+        for (j = 0; j < m; j++) xb[j] = vb[j];
+        break;
+    case PSICRO_H:
+        for (j = 0; j < m; j++) xb[j] = (vb[j] - (CPAS * tb[j])) / (LAMBDA + CPV * tb[j]);
+        break;
+    case PSICRO_VAU:
+        for (j = 0; j < m; j++) xb[j] = ((vb[j] * p) / (RA * (tb[j] + 273.15)) - 1.0) * RAV;
+        break;
+    case PSICRO_TBU: // ab = hs_bu - xs_bu * hw_bu, bb = hw_bu (EQ. (33) AFH 2017)
+        for (j = 0; j < m; j++) xb[j] = (ab[j] - CPAS * tb[j]) / (LAMBDA + CPV * tb[j] - bb[j]);
+        break;
+    case PSICRO_TR:  // ab = xsat(tr)
+        for (j = 0; j < m; j++) xb[j] = ab[j];
+        break;
+    }
+}
+
+static void riga_target(int target, int idv, int m, const double* tb, const double* pb, const double* vb,
+    const double* xb, double p, double* o) {
+    int j;
+    if (target == PSICRO_T) {
+        memcpy(o, tb, m * sizeof(double));
+        return;
+    }
+    if (target == idv) {
+        memcpy(o, vb, m * sizeof(double));
+        return;
+    }
+    switch (target) {
+    case PSICRO_X:
+        memcpy(o, xb, m * sizeof(double));
+        break;
+    case PSICRO_H:
+        for (j = 0; j < m; j++) o[j] = (CPAS * tb[j]) + xb[j] * (LAMBDA + CPV * tb[j]);
+        break;
+    case PSICRO_VAU:
+        for (j = 0; j < m; j++) o[j] = RA * (tb[j] + 273.15) * (1.0 + ((xb[j] <= 0.000001) ? 0.0 : xb[j]) / RAV) / p;
+        break;
+    case PSICRO_UR:
+        for (j = 0; j < m; j++) {
+            double ur = ((xb[j] * p) / (RAV + xb[j])) / pb[j] * 100.0;
+            ur = (ur >= 100.0) ? 100.0 : ((ur <= 0.0) ? 0.0 : ur);
+            o[j] = (xb[j] <= 0.0) ? 0.0 : ur;
+        }
+        break;
+    default: // tr, tbu: solutori iterativi, uno per cella
+        for (j = 0; j < m; j++) o[j] = core_target_t_x(target, tb[j], xb[j], pb[j], p);
+        break;
+    }
+}
+
+static int griglia_generica(int id1, const double* asse1, int n1, int id2, const double* asse2, int n2,
+    int target, double* out) {
+    psicro_fn fn = psicro_funzione(target, id1, id2);
+    if (fn == NULL && target != id1 && target != id2) return PSICRO_ERR_NON_SUPP;
+    int ordine = (id1 < id2);
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < n1; i++) {
+        double* o = out + (long long)i * n2;
+        for (int j = 0; j < n2; j++) {
+            if (target == id1) o[j] = asse1[i];
+            else if (target == id2) o[j] = asse2[j];
+            else o[j] = ordine ? fn(asse1[i], asse2[j]) : fn(asse2[j], asse1[i]);
+        }
+    }
+    return PSICRO_OK;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_griglia(int id1, const double* asse1, int n1,
+    int id2, const double* asse2, int n2, int target, double* out) {
+    if (!asse1 || !asse2 || !out || n1 <= 0 || n2 <= 0 || id1 == id2) return PSICRO_ERR_ARG;
+    if (id1 < 0 || id1 >= PSICRO_N_PROP || id2 < 0 || id2 >= PSICRO_N_PROP || target < 0 || target >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+    int t_su_1 = (id1 == PSICRO_T);
+    if (!t_su_1 && id2 != PSICRO_T) return griglia_generica(id1, asse1, n1, id2, asse2, n2, target, out);
+
+    const double p = PATM;
+    const double* at = t_su_1 ? asse1 : asse2;
+    const double* av = t_su_1 ? asse2 : asse1;
+    const int nt = t_su_1 ? n1 : n2;
+    const int nv = t_su_1 ? n2 : n1;
+    const int idv = t_su_1 ? id2 : id1;
+
+    // 1. Lavoro per asse
+    double* ps_t = (double*)malloc(nt * sizeof(double));
+    double* aux_a = (double*)calloc(nv, sizeof(double));
+    double* aux_b = (double*)calloc(nv, sizeof(double));
+    if (!ps_t || !aux_a || !aux_b) {
+        free(ps_t);
+        free(aux_a);
+        free(aux_b);
+        return PSICRO_ERR_MEM;
+    }
+    for (int i = 0; i < nt; i++) ps_t[i] = core_Psat(at[i]);
+    for (int i = 0; i < nv; i++) {
+        if (idv == PSICRO_TBU) {
+            double xs_bu = core_xsat_t(av[i], p);
+            double hw_bu = core_hw_bu(av[i]);
+            aux_a[i] = core_h_t_x(av[i], xs_bu) - xs_bu * hw_bu;
+            aux_b[i] = hw_bu;
+        }
+        else if (idv == PSICRO_TR) {
+            aux_a[i] = core_xsat_t(av[i], p);
+        }
+    }
+
+    // 2. Blocchi distribuiti sui thread
+    const int nbi = (n1 + PSICRO_GRID_TILE_I - 1) / PSICRO_GRID_TILE_I;
+    const int nbj = (n2 + TJ - 1) / TJ;
+#pragma omp parallel for schedule(dynamic)
+    for (int b = 0; b < nbi * nbj; b++) {
+        double tb[TJ], pb[TJ], vb[TJ], ab[TJ], bb[TJ], xb[TJ];
+        const int i0 = (b / nbj) * PSICRO_GRID_TILE_I;
+        const int j0 = (b % nbj) * TJ;
+        const int i1 = (i0 + PSICRO_GRID_TILE_I < n1) ? i0 + PSICRO_GRID_TILE_I : n1;
+        const int m = (j0 + TJ < n2) ? TJ : n2 - j0;
+        for (int i = i0; i < i1; i++) {
+            for (int j = 0; j < m; j++) {
+                const int it = t_su_1 ? i : j0 + j;   // indice sull'asse di t
+                const int iv = t_su_1 ? j0 + j : i;   // indice sull'altro asse
+                tb[j] = at[it];
+                pb[j] = ps_t[it];
+                vb[j] = av[iv];
+                ab[j] = aux_a[iv];
+                bb[j] = aux_b[iv];
+            }
+            riga_x(idv, m, tb, pb, vb, ab, bb, p, xb);
+            riga_target(target, idv, m, tb, pb, vb, xb, p, out + (long long)i * n2 + j0);
+        }
+    }
+    free(ps_t);
+    free(aux_a);
+    free(aux_b);
+    return PSICRO_OK;
+}
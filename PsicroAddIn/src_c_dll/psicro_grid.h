@@ -0,0 +1,19 @@
+#ifndef PSICRO_GRID_H
+#define PSICRO_GRID_H
+
+#include "psicrometria.h"
+
+// --- VALUTAZIONE SU GRIGLIA CARTESIANA ---
+// out[i * n2 + j] = target(asse1[i], asse2[j]) alla pressione PATM corrente.
+// Se una delle due grandezze è t, il lavoro per asse (Psat(t), titolo di
+// saturazione per tr, termini di bulbo umido per tbu) si calcola una volta sola
+// fuori dal ciclo interno; il ciclo interno è aritmetica su vettori contigui
+// (vettorizzabile) e i blocchi PSICRO_GRID_TILE_I x PSICRO_GRID_TILE_J si
+// distribuiscono sui thread. Le altre coppie usano le funzioni scalari.
+#define PSICRO_GRID_TILE_I  16
+#define PSICRO_GRID_TILE_J  256
+
+PSICRO_EXPORT int PSICRO_CALL psicro_griglia(int id1, const double* asse1, int n1,
+	int id2, const double* asse2, int n2, int target, double* out);
+
+#endif
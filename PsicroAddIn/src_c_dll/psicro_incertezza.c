@@ -0,0 +1,229 @@
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicro_incertezza.h"
+#include "psicro_core.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCCO_MC  256   // Campioni generati e valutati per volta
+#define NODI       17    // Nodi per lato della griglia di interpolazione
+#define CLASSI_Q   4096  // Classi dell'istogramma per i quantili
+
+// --- GENERATORE A CONTATORE ---
+// splitmix64 applicato a (chiave + contatore * gamma): ogni (riga, campione)
+// ha il proprio valore senza stato condiviso tra i thread.
+static uint64_t mescola(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+static double uniforme(uint64_t chiave, uint64_t contatore) {
+    // 53 bit -> (0, 1)
+    return ((double)(mescola(chiave + contatore * 0x9E3779B97F4A7C15ull) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+// --- MONOTONIA ---
+// Con v2 = ur, x o tr ogni grandezza è monotona in t e in v2 separatamente:
+// gli estremi sulla banda stanno nei vertici.
+static int monotona(int id2) {
+    return (id2 == PSICRO_UR || id2 == PSICRO_X || id2 == PSICRO_TR);
+}
+
+static double valuta(int id2, int target, double t, double v2, double patm) {
+    core_termini_t k;
+    core_termini(id2, t, v2, &k);
+    double x = core_x_coppia_t(id2, t, v2, &k, patm);
+    return core_target_t_x(target, t, x, k.ps_t, patm);
+}
+
+// Quantile 'perc' di a[0..n-1] in [lo, hi] da un istogramma a CLASSI_Q classi,
+// interpolato nella classe: una passata, risoluzione (hi - lo) / CLASSI_Q
+static void quantili(const double* a, long long n, double lo, double hi, int* conta, double* q_lo, double* q_hi) {
+    if (!(hi > lo)) {
+        *q_lo = *q_hi = lo;
+        return;
+    }
+    const double scala = CLASSI_Q / (hi - lo);
+    memset(conta, 0, CLASSI_Q * sizeof(int));
+    for (long long s = 0; s < n; s++) {
+        int k = (int)((a[s] - lo) * scala);
+        conta[(k >= CLASSI_Q) ? CLASSI_Q - 1 : k]++;
+    }
+    const double rango[2] = { PSICRO_INC_Q_LO / 100.0 * (double)n, PSICRO_INC_Q_HI / 100.0 * (double)n };
+    double* q[2] = { q_lo, q_hi };
+    long long cum = 0;
+    int j = 0;
+    for (int k = 0; k < CLASSI_Q && j < 2; k++) {
+        while (j < 2 && (double)(cum + conta[k]) >= rango[j]) {
+            double f = (conta[k] > 0) ? (rango[j] - (double)cum) / (double)conta[k] : 0.0;
+            *q[j++] = lo + (k + f) / scala;
+        }
+        cum += conta[k];
+    }
+    while (j < 2) *q[j++] = hi;
+}
+
+// --- MONTE CARLO DI UNA RIGA ---
+// La banda di tolleranza è piccola: le grandezze si calcolano esattamente su una
+// griglia NODI x NODI che copre il supporto dei campioni e i campioni si valutano
+// per interpolazione bilineare. Le inversioni iterative (tbu, tr) costano così
+// NODI² chiamate per riga invece di una per campione.
+// campioni: n_target * n_campioni valori, nodi: n_target * NODI * NODI, conta: CLASSI_Q (buffer del thread)
+static void monte_carlo(int id2, double t, double v2, double tol_t, double tol_v2, int forma,
+    const int* target, int n_target, long long n_campioni, uint64_t chiave, double patm,
+    double* campioni, double* nodi, int* conta, psicro_incertezza_out* o) {
+    // 1. Supporto: la banda (uniforme) o +/- 4 sigma (normale, oltre si estrapola)
+    const double ampiezza = (forma == PSICRO_INC_NORMALE) ? 2.0 : 1.0;
+    double t0 = t - ampiezza * tol_t, t1 = t + ampiezza * tol_t;
+    double w0 = v2 - ampiezza * tol_v2, w1 = v2 + ampiezza * tol_v2;
+    if (id2 == PSICRO_UR) {
+        if (w0 < 0.0) w0 = 0.0;
+        if (w1 > 100.0) w1 = 100.0;
+    }
+    const double dt = (t1 - t0) / (NODI - 1), dw = (w1 - w0) / (NODI - 1);
+    const double inv_dt = (dt > 0.0) ? 1.0 / dt : 0.0, inv_dw = (dw > 0.0) ? 1.0 / dw : 0.0;
+    for (int a = 0; a < NODI; a++) {
+        for (int b = 0; b < NODI; b++) {
+            double tn = t0 + a * dt, wn = w0 + b * dw;
+            core_termini_t k;
+            core_termini(id2, tn, wn, &k);
+            double x = core_x_coppia_t(id2, tn, wn, &k, patm);
+            for (int c = 0; c < n_target; c++) {
+                nodi[(c * NODI + a) * NODI + b] = core_target_t_x(target[c], tn, x, k.ps_t, patm);
+            }
+        }
+    }
+
+    double at[BLOCCO_MC], av[BLOCCO_MC];
+    int ia[BLOCCO_MC], ib[BLOCCO_MC];
+    for (long long s0 = 0; s0 < n_campioni; s0 += BLOCCO_MC) {
+        int m = (int)((s0 + BLOCCO_MC < n_campioni) ? BLOCCO_MC : n_campioni - s0);
+        // 2. Ingressi del blocco, come coordinate nella griglia
+        for (int s = 0; s < m; s++) {
+            uint64_t c = (uint64_t)(s0 + s) * 2;
+            double u1 = uniforme(chiave, c), u2 = uniforme(chiave, c + 1);
+            double ts, ws;
+            if (forma == PSICRO_INC_NORMALE) {
+                // Box-Muller: una coppia di normali indipendenti
+                double r = sqrt(-2.0 * log(u1));
+                ts = t + 0.5 * tol_t * r * cos(6.283185307179586 * u2);
+                ws = v2 + 0.5 * tol_v2 * r * sin(6.283185307179586 * u2);
+            }
+            else {
+                ts = t + tol_t * (2.0 * u1 - 1.0);
+                ws = v2 + tol_v2 * (2.0 * u2 - 1.0);
+            }
+            if (id2 == PSICRO_UR) ws = (ws < 0.0) ? 0.0 : ((ws > 100.0) ? 100.0 : ws);
+            double ft = (ts - t0) * inv_dt, fw = (ws - w0) * inv_dw;
+            int ka = (int)floor(ft), kb = (int)floor(fw);
+            ka = (ka < 0) ? 0 : ((ka > NODI - 2) ? NODI - 2 : ka);
+            kb = (kb < 0) ? 0 : ((kb > NODI - 2) ? NODI - 2 : kb);
+            ia[s] = ka;
+            ib[s] = kb;
+            at[s] = ft - ka;   // fuori da [0, 1] solo in estrapolazione
+            av[s] = fw - kb;
+        }
+        // 3. Interpolazione bilineare per target
+        for (int c = 0; c < n_target; c++) {
+            const double* g = nodi + c * NODI * NODI;
+            double* dst = campioni + c * n_campioni + s0;
+            for (int s = 0; s < m; s++) {
+                const double* p = g + ia[s] * NODI + ib[s];
+                double f0 = p[0] + av[s] * (p[1] - p[0]);
+                double f1 = p[NODI] + av[s] * (p[NODI + 1] - p[NODI]);
+                dst[s] = f0 + at[s] * (f1 - f0);
+            }
+        }
+    }
+    // 3. Statistiche per target
+    for (int c = 0; c < n_target; c++) {
+        double* a = campioni + c * n_campioni;
+        double somma = 0.0, lo = a[0], hi = a[0];
+        for (long long s = 0; s < n_campioni; s++) {
+            somma += a[s];
+            if (a[s] < lo) lo = a[s];
+            if (a[s] > hi) hi = a[s];
+        }
+        double media = somma / (double)n_campioni;
+        double q = 0.0;
+        for (long long s = 0; s < n_campioni; s++) q += (a[s] - media) * (a[s] - media);
+        o[c].media = media;
+        o[c].dev_std = (n_campioni > 1) ? sqrt(q / (double)(n_campioni - 1)) : 0.0;
+        quantili(a, n_campioni, lo, hi, conta, &o[c].q_lo, &o[c].q_hi);
+        if (!o[c].limiti_esatti) {
+            o[c].lo = lo;
+            o[c].hi = hi;
+        }
+    }
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_incertezza(int id2, const double* t, const double* v2, long long n,
+    double tol_t, double tol_v2, int forma, const int* target, int n_target,
+    long long n_campioni, unsigned long long seme, psicro_incertezza_out* out) {
+    if (!t || !v2 || !target || !out || n <= 0 || n_target <= 0 || n_campioni < 0 || tol_t < 0.0 || tol_v2 < 0.0) return PSICRO_ERR_ARG;
+    if (forma != PSICRO_INC_UNIFORME && forma != PSICRO_INC_NORMALE) return PSICRO_ERR_ARG;
+    if (id2 < PSICRO_UR || id2 > PSICRO_TR) return PSICRO_ERR_NON_SUPP;
+    for (int c = 0; c < n_target; c++) {
+        if (target[c] < 0 || target[c] >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+    }
+    const double patm = PATM;
+    const int esatti = monotona(id2);
+    int err = PSICRO_OK;
+
+#pragma omp parallel
+    {
+        double* campioni = NULL;
+        double* nodi = NULL;
+        int* conta = NULL;
+        if (n_campioni > 0) {
+            campioni = (double*)malloc((size_t)n_campioni * n_target * sizeof(double));
+            nodi = (double*)malloc((size_t)NODI * NODI * n_target * sizeof(double));
+            conta = (int*)malloc(CLASSI_Q * sizeof(int));
+            if (campioni == NULL || nodi == NULL || conta == NULL) {
+                free(campioni);
+                campioni = NULL;
+#pragma omp critical(psicro_incertezza_err)
+                err = PSICRO_ERR_MEM;
+            }
+        }
+#pragma omp for schedule(dynamic, 16)
+        for (long long i = 0; i < n; i++) {
+            psicro_incertezza_out* o = out + i * n_target;
+            // Limiti dai vertici (anche come riferimento se non monotona)
+            double vt[2] = { t[i] - tol_t, t[i] + tol_t };
+            double vv[2] = { v2[i] - tol_v2, v2[i] + tol_v2 };
+            if (id2 == PSICRO_UR) {
+                if (vv[0] < 0.0) vv[0] = 0.0;
+                if (vv[1] > 100.0) vv[1] = 100.0;
+            }
+            for (int c = 0; c < n_target; c++) {
+                o[c].nominale = valuta(id2, target[c], t[i], v2[i], patm);
+                o[c].limiti_esatti = esatti;
+                o[c].lo = o[c].hi = o[c].nominale;
+                if (esatti) {
+                    for (int a = 0; a < 2; a++) {
+                        for (int b = 0; b < 2; b++) {
+                            double f = valuta(id2, target[c], vt[a], vv[b], patm);
+                            if (f < o[c].lo) o[c].lo = f;
+                            if (f > o[c].hi) o[c].hi = f;
+                        }
+                    }
+                }
+                o[c].media = o[c].dev_std = o[c].q_lo = o[c].q_hi = NAN;
+            }
+            if (campioni != NULL) {
+                uint64_t chiave = mescola((uint64_t)seme ^ mescola((uint64_t)i + 1));
+                monte_carlo(id2, t[i], v2[i], tol_t, tol_v2, forma, target, n_target, n_campioni, chiave, patm, campioni, nodi, conta, o);
+            }
+            else if (!esatti) {
+                o->limiti_esatti = 0; // Limiti non disponibili senza campioni
+                for (int c = 0; c < n_target; c++) o[c].lo = o[c].hi = NAN;
+            }
+        }
+        free(campioni);
+        free(nodi);
+        free(conta);
+    }
+    return err;
+}
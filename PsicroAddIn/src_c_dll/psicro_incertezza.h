@@ -0,0 +1,39 @@
+#ifndef PSICRO_INCERTEZZA_H
+#define PSICRO_INCERTEZZA_H
+
+#include "psicrometria.h"
+
+// --- PROPAGAZIONE DELL'INCERTEZZA DEI SENSORI ---
+// Per ogni riga (t, v2) con tolleranze +/- tol_t e +/- tol_v2 si calcolano:
+//  - i limiti dell'uscita sulla banda di tolleranza. Se la grandezza è
+//    monotona in ciascun ingresso (coppie t-ur, t-x, t-tr) bastano i 4 vertici;
+//    altrimenti si usano minimo e massimo dei campioni Monte Carlo;
+//  - con n_campioni > 0, media, scarto tipo e quantili dai campioni Monte Carlo.
+//    I campioni si valutano per interpolazione bilineare su una griglia 17x17
+//    calcolata esattamente sul supporto della riga (errore ~1e-4 sulle bande
+//    tipiche dei sensori); i quantili hanno risoluzione (max - min) / 4096.
+// Il generatore è a contatore (chiave = seme e riga, contatore = campione): i
+// risultati non dipendono dal numero di thread né dall'ordine delle righe.
+#define PSICRO_INC_UNIFORME  0   // Ingressi uniformi nella banda +/- tol
+#define PSICRO_INC_NORMALE   1   // Ingressi normali con sigma = tol / 2 (tol = incertezza estesa, k = 2)
+
+#define PSICRO_INC_Q_LO      2.5   // Quantili riportati [%]
+#define PSICRO_INC_Q_HI     97.5
+
+typedef struct {
+	double nominale;        // Valore alle medie
+	double lo, hi;          // Limiti sulla banda di tolleranza
+	int limiti_esatti;      // 1 = limiti da monotonia (vertici), 0 = min/max dei campioni
+	double media, dev_std;  // Monte Carlo (NAN se n_campioni = 0)
+	double q_lo, q_hi;      // Quantili PSICRO_INC_Q_LO / PSICRO_INC_Q_HI (Monte Carlo)
+} psicro_incertezza_out;
+
+// id2:        grandezza nota insieme a t (PSICRO_UR ... PSICRO_TR)
+// target:     n_target indici PSICRO_* da calcolare
+// n_campioni: campioni Monte Carlo per riga (0 = solo limiti, ove esatti)
+// out:        n * n_target risultati, disposti [riga][target]
+PSICRO_EXPORT int PSICRO_CALL psicro_incertezza(int id2, const double* t, const double* v2, long long n,
+	double tol_t, double tol_v2, int forma, const int* target, int n_target,
+	long long n_campioni, unsigned long long seme, psicro_incertezza_out* out);
+
+#endif
@@ -0,0 +1,166 @@
+#include "psicro_job.h"
+#include "psicro_thread.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct psicro_job {
+    psicro_job_spec spec;
+    double patm;                 // PATM al momento della submit
+    long long n_blocchi;
+    long long prossimo;          // Prossimo blocco da assegnare
+    long long fatte;             // Righe completate
+    long long* coda;             // Blocchi completati (ognuno entra una sola volta)
+    long long coda_testa, coda_fondo;
+    int annulla;
+    int attivi;                  // Thread ancora in esecuzione
+    int stato;
+    int n_thread;
+    psicro_thread_t* thread;
+    psicro_mutex mtx;
+    psicro_cond cnd;
+};
+
+static void lavora(psicro_job* job) {
+    const psicro_job_spec* s = &job->spec;
+    for (;;) {
+        psicro_mutex_lock(&job->mtx);
+        if (job->annulla || job->prossimo >= job->n_blocchi) {
+            if (--job->attivi == 0) {
+                job->stato = (job->fatte == s->n) ? PSICRO_JOB_COMPLETATO : PSICRO_JOB_ANNULLATO;
+                psicro_cond_broadcast(&job->cnd);
+            }
+            psicro_mutex_unlock(&job->mtx);
+            return;
+        }
+        long long b = job->prossimo++;
+        psicro_mutex_unlock(&job->mtx);
+
+        long long i0 = b * s->blocco;
+        long long m = (i0 + s->blocco < s->n) ? s->blocco : s->n - i0;
+        psicro_batch_blocco(s->target, s->id1, s->v1 + i0, s->id2, s->v2 + i0, m, job->patm, s->out + i0);
+        if (s->cb) s->cb(s->utente, i0, i0 + m);
+
+        psicro_mutex_lock(&job->mtx);
+        job->fatte += m;
+        job->coda[job->coda_fondo++] = b;
+        psicro_cond_broadcast(&job->cnd);
+        psicro_mutex_unlock(&job->mtx);
+    }
+}
+
+static psicro_thread_ret PSICRO_THREAD_FN thread_main(void* arg) {
+    lavora((psicro_job*)arg);
+    return 0;
+}
+
+PSICRO_EXPORT psicro_job* PSICRO_CALL psicro_job_submit(const psicro_job_spec* spec) {
+    if (!spec || !spec->v1 || !spec->v2 || !spec->out || spec->n <= 0 || spec->id1 == spec->id2) return NULL;
+    if (spec->id1 < 0 || spec->id1 >= PSICRO_N_PROP || spec->id2 < 0 || spec->id2 >= PSICRO_N_PROP ||
+        spec->target < 0 || spec->target >= PSICRO_N_PROP) return NULL;
+    if (spec->target != spec->id1 && spec->target != spec->id2 &&
+        psicro_funzione(spec->target, spec->id1, spec->id2) == NULL) return NULL;
+
+    psicro_job* job = (psicro_job*)calloc(1, sizeof(psicro_job));
+    if (!job) return NULL;
+    job->spec = *spec;
+    if (job->spec.blocco <= 0) job->spec.blocco = 65536;
+    job->patm = PATM;
+    job->n_blocchi = (spec->n + job->spec.blocco - 1) / job->spec.blocco;
+    job->n_thread = (spec->n_thread > 0) ? spec->n_thread : psicro_numero_cpu();
+    if (job->n_thread > job->n_blocchi) job->n_thread = (int)job->n_blocchi;
+    job->coda = (long long*)malloc(job->n_blocchi * sizeof(long long));
+    job->thread = (psicro_thread_t*)calloc(job->n_thread, sizeof(psicro_thread_t));
+    if (!job->coda || !job->thread) {
+        free(job->coda);
+        free(job->thread);
+        free(job);
+        return NULL;
+    }
+    psicro_mutex_init(&job->mtx);
+    psicro_cond_init(&job->cnd);
+    job->stato = PSICRO_JOB_IN_CORSO;
+    job->attivi = job->n_thread;
+
+    psicro_mutex_lock(&job->mtx);
+    for (int i = 0; i < job->n_thread; i++) {
+        if (!psicro_thread_create(&job->thread[i], thread_main, job)) {
+            // Lavorano i thread già creati; se nessuno è partito il job fallisce
+            job->attivi -= job->n_thread - i;
+            job->n_thread = i;
+            break;
+        }
+    }
+    psicro_mutex_unlock(&job->mtx);
+    if (job->n_thread == 0) {
+        psicro_job_free(job);
+        return NULL;
+    }
+    return job;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_job_poll(psicro_job* job, long long* fatte, long long* totale) {
+    if (!job) return PSICRO_ERR_ARG;
+    psicro_mutex_lock(&job->mtx);
+    int stato = job->stato;
+    if (fatte) *fatte = job->fatte;
+    if (totale) *totale = job->spec.n;
+    psicro_mutex_unlock(&job->mtx);
+    return stato;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_job_wait(psicro_job* job, int timeout_ms) {
+    if (!job) return PSICRO_ERR_ARG;
+    psicro_mutex_lock(&job->mtx);
+    if (job->stato == PSICRO_JOB_IN_CORSO) {
+        if (timeout_ms < 0) {
+            while (job->stato == PSICRO_JOB_IN_CORSO) psicro_cond_wait(&job->cnd, &job->mtx, -1);
+        }
+        else {
+            // Ogni blocco completato risveglia l'attesa: si riattende il tempo residuo
+            const unsigned long long scadenza = psicro_ora_ns() + (unsigned long long)timeout_ms * 1000000ULL;
+            while (job->stato == PSICRO_JOB_IN_CORSO) {
+                const unsigned long long ora = psicro_ora_ns();
+                if (ora >= scadenza) break;
+                psicro_cond_wait(&job->cnd, &job->mtx, (int)((scadenza - ora + 999999ULL) / 1000000ULL));
+            }
+        }
+    }
+    int stato = (job->stato == PSICRO_JOB_IN_CORSO) ? PSICRO_JOB_TIMEOUT : job->stato;
+    psicro_mutex_unlock(&job->mtx);
+    return stato;
+}
+
+PSICRO_EXPORT void PSICRO_CALL psicro_job_cancel(psicro_job* job) {
+    if (!job) return;
+    psicro_mutex_lock(&job->mtx);
+    job->annulla = 1;
+    psicro_mutex_unlock(&job->mtx);
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_job_next(psicro_job* job, long long* inizio, long long* fine) {
+    if (!job) return 0;
+    int trovato = 0;
+    psicro_mutex_lock(&job->mtx);
+    if (job->coda_testa < job->coda_fondo) {
+        long long b = job->coda[job->coda_testa++];
+        long long i0 = b * job->spec.blocco;
+        if (inizio) *inizio = i0;
+        if (fine) *fine = (i0 + job->spec.blocco < job->spec.n) ? i0 + job->spec.blocco : job->spec.n;
+        trovato = 1;
+    }
+    psicro_mutex_unlock(&job->mtx);
+    return trovato;
+}
+
+PSICRO_EXPORT void PSICRO_CALL psicro_job_free(psicro_job* job) {
+    if (!job) return;
+    psicro_job_cancel(job);
+    for (int i = 0; i < job->n_thread; i++) {
+        psicro_thread_join(job->thread[i]);
+    }
+    psicro_mutex_destroy(&job->mtx);
+    psicro_cond_destroy(&job->cnd);
+    free(job->coda);
+    free(job->thread);
+    free(job);
+}
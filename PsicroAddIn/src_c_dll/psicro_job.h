@@ -0,0 +1,48 @@
+#ifndef PSICRO_JOB_H
+#define PSICRO_JOB_H
+
+#include "psicrometria.h"
+
+// --- CALCOLO ASINCRONO ---
+// psicro_job_submit avvia un batch su thread propri e ritorna subito.
+// Il lavoro è diviso in blocchi di 'blocco' righe: ogni blocco completato si
+// può ricevere con la callback (chiamata dal thread di calcolo) oppure
+// prelevare con psicro_job_next (coda). poll/wait/cancel sono sicure da
+// qualsiasi thread; psicro_job_free attende la fine dei thread.
+// Tutte le righe si calcolano alla PATM del momento della submit, anche se
+// PATM cambia mentre il job è in corso.
+
+// Stati del job
+#define PSICRO_JOB_COMPLETATO   0
+#define PSICRO_JOB_IN_CORSO     1
+#define PSICRO_JOB_ANNULLATO    2
+#define PSICRO_JOB_TIMEOUT      3     // Solo come ritorno di psicro_job_wait
+
+typedef void (PSICRO_CALL *psicro_job_cb)(void* utente, long long inizio, long long fine);
+
+typedef struct {
+	int target, id1, id2;        // Indici PSICRO_*
+	const double* v1;            // n valori di id1 (devono restare validi fino alla fine del job)
+	const double* v2;            // n valori di id2
+	double* out;                 // n risultati
+	long long n;
+	long long blocco;            // Righe per blocco (<= 0 -> 65536)
+	int n_thread;                // Thread di calcolo (<= 0 -> numero di CPU)
+	psicro_job_cb cb;            // Opzionale: notifica dei blocchi completati [inizio, fine)
+	void* utente;
+} psicro_job_spec;
+
+typedef struct psicro_job psicro_job;
+
+PSICRO_EXPORT psicro_job* PSICRO_CALL psicro_job_submit(const psicro_job_spec* spec);
+// Stato corrente; righe completate e totali in *fatte e *totale (opzionali)
+PSICRO_EXPORT int PSICRO_CALL psicro_job_poll(psicro_job* job, long long* fatte, long long* totale);
+// Attende la fine del job (timeout_ms < 0: senza limite); PSICRO_JOB_TIMEOUT se scade
+PSICRO_EXPORT int PSICRO_CALL psicro_job_wait(psicro_job* job, int timeout_ms);
+// Richiede l'annullamento: i blocchi già avviati terminano, i successivi no
+PSICRO_EXPORT void PSICRO_CALL psicro_job_cancel(psicro_job* job);
+// Preleva il prossimo blocco completato; 1 se disponibile, 0 altrimenti
+PSICRO_EXPORT int PSICRO_CALL psicro_job_next(psicro_job* job, long long* inizio, long long* fine);
+PSICRO_EXPORT void PSICRO_CALL psicro_job_free(psicro_job* job);
+
+#endif
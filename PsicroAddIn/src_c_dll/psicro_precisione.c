@@ -0,0 +1,85 @@
+#include "psicro_precisione.h"
+#include <math.h>
+
+const psicro_tolleranze psicro_profili[PSICRO_N_PREC] = {
+    // tpsat_eps_p = 1e30: conta solo il passo (Newton converge quadraticamente).
+    // Le bisezioni si accorciano con bisez_eps_t e non allentando il residuo: vicino
+    // a 0 °C il bilancio ha un salto (acqua/ghiaccio) e un residuo largo può fermarsi
+    // su un'altra radice; con l'ampiezza si segue lo stesso percorso del riferimento.
+    // tpsat_eps_p  tpsat_eps_t  newton_eps_t_h  newton_eps_t_vau  tbu_eps_f  t_tbu_eps_f  bisez_eps_t
+    {  1e-7,        1e-5,        1e-13,          1e-12,            1e-8,      1e-6,        0.0  },  // RIFERIMENTO
+    {  1e30,        1e-6,        1e-6,           1e-6,             1e-8,      1e-6,        1e-6 },  // STANDARD
+    {  1e30,        1e-3,        1e-3,           1e-3,             1e-8,      1e-6,        1e-3 },  // INGEGNERIA
+};
+volatile int PSICRO_PREC = PSICRO_PREC_RIFERIMENTO;
+PSICRO_TLS const psicro_tolleranze* psicro_prec_thread = NULL;
+PSICRO_TLS psicro_contesto psicro_ctx = { PSICRO_STATO_OK, 0 };
+
+PSICRO_EXPORT int PSICRO_CALL psicro_stato(void) { return psicro_ctx.stato; }
+PSICRO_EXPORT int PSICRO_CALL psicro_valutazioni(void) { return psicro_ctx.valutazioni; }
+
+PSICRO_EXPORT int PSICRO_CALL psicro_set_precisione(int profilo) {
+    if (profilo < 0 || profilo >= PSICRO_N_PREC) return PSICRO_ERR_ARG;
+    int prec = PSICRO_PREC;
+    PSICRO_PREC = profilo;
+    return prec;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_set_precisione_thread(int profilo) {
+    if (profilo < -1 || profilo >= PSICRO_N_PREC) return PSICRO_ERR_ARG;
+    int prec = psicro_prec_thread ? (int)(psicro_prec_thread - psicro_profili) : -1;
+    psicro_prec_thread = (profilo < 0) ? NULL : &psicro_profili[profilo];
+    return prec;
+}
+
+PSICRO_EXPORT double PSICRO_CALL psicro_calc_prec(int target, int id1, double v1, int id2, double v2, int profilo) {
+    if (profilo < 0 || profilo >= PSICRO_N_PREC) return NAN;
+    const psicro_tolleranze* salva = psicro_prec_thread;
+    psicro_prec_thread = &psicro_profili[profilo];
+    double r = psicro_calc(target, id1, v1, id2, v2);
+    psicro_prec_thread = salva;
+    return r;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_batch_prec(int target, int id1, const double* v1, int id2, const double* v2,
+    long long n, int profilo, double* out) {
+    if (!v1 || !v2 || !out || n <= 0 || id1 == id2 || profilo < 0 || profilo >= PSICRO_N_PREC) return PSICRO_ERR_ARG;
+    if (id1 < 0 || id1 >= PSICRO_N_PROP || id2 < 0 || id2 >= PSICRO_N_PROP || target < 0 || target >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+    const double p = PATM;
+    const long long blocco = 4096;
+    const long long n_blocchi = (n + blocco - 1) / blocco;
+#pragma omp parallel
+    {
+        // Il profilo vive nel TLS: lo imposta ogni thread del team
+        const psicro_tolleranze* salva = psicro_prec_thread;
+        psicro_prec_thread = &psicro_profili[profilo];
+#pragma omp for schedule(dynamic)
+        for (long long b = 0; b < n_blocchi; b++) {
+            long long i0 = b * blocco;
+            long long m = (i0 + blocco < n) ? blocco : n - i0;
+            psicro_batch_blocco(target, id1, v1 + i0, id2, v2 + i0, m, p, out + i0);
+        }
+        psicro_prec_thread = salva;
+    }
+    return PSICRO_OK;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_batch_stato(int target, int id1, const double* v1, int id2, const double* v2,
+    long long n, double* out, unsigned char* stato) {
+    if (!v1 || !v2 || !out || !stato || n <= 0 || id1 == id2) return PSICRO_ERR_ARG;
+    if (id1 < 0 || id1 >= PSICRO_N_PROP || id2 < 0 || id2 >= PSICRO_N_PROP || target < 0 || target >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+    const double p = PATM;
+    psicro_fn_p fn = psicro_funzione_p(target, id1, id2);
+    // Lo stato è per riga: gli adattatori lo azzerano a ogni chiamata
+#pragma omp parallel for schedule(dynamic, 4096)
+    for (long long i = 0; i < n; i++) {
+        if (target == id1 || target == id2) {
+            out[i] = (target == id1) ? v1[i] : v2[i];
+            stato[i] = PSICRO_STATO_OK;
+            continue;
+        }
+        out[i] = (id1 < id2) ? fn(v1[i], v2[i], p) : fn(v2[i], v1[i], p);
+        stato[i] = (unsigned char)psicro_ctx.stato;
+    }
+    return PSICRO_OK;
+}
@@ -0,0 +1,95 @@
+#ifndef PSICRO_PRECISIONE_H
+#define PSICRO_PRECISIONE_H
+
+#include "psicrometria.h"
+#include "psicro_thread.h"
+#include <limits.h>
+
+// --- PROFILI DI PRECISIONE DEI SOLUTORI ITERATIVI ---
+// Tutti i solutori (TPsat, bisezione di tbu, Newton di t_ur_h / t_ur_vau,
+// bisezione di t_ur_tbu) leggono le tolleranze dal profilo attivo: quello del
+// thread se impostato, altrimenti quello di processo. Il profilo di riferimento
+// (predefinito) conserva le tolleranze storiche e quindi i risultati di sempre.
+#define PSICRO_PREC_RIFERIMENTO   0   // Tolleranze storiche (1e-13 .. 1e-5)
+#define PSICRO_PREC_STANDARD      1   // ~1e-6 K
+#define PSICRO_PREC_INGEGNERIA    2   // ~1e-3 K, oltre la risoluzione dei sensori
+#define PSICRO_N_PREC             3
+
+typedef struct {
+	double tpsat_eps_p;     // TPsat: residuo di pressione [kPa]
+	double tpsat_eps_t;     // TPsat: passo di Newton [K]
+	double newton_eps_t_h;   // t_ur_h (e solutore (t, x)): passo di Newton [K]
+	double newton_eps_t_vau; // t_ur_vau: passo di Newton [K]
+	double tbu_eps_f;       // tbu_x_h: residuo del bilancio [kJ/kg]
+	double t_tbu_eps_f;     // t_ur_tbu: residuo del bilancio [kJ/kg]
+	double bisez_eps_t;     // Bisezioni: semiampiezza dell'intervallo [K] (0 = solo residuo)
+} psicro_tolleranze;
+
+extern const psicro_tolleranze psicro_profili[PSICRO_N_PREC];
+extern volatile int PSICRO_PREC;                                // Profilo di processo
+extern PSICRO_TLS const psicro_tolleranze* psicro_prec_thread;  // Profilo del thread (NULL = processo)
+
+// Tolleranze attive per il thread chiamante
+PSICRO_INLINE const psicro_tolleranze* psicro_prec_attiva(void) {
+	const psicro_tolleranze* p = psicro_prec_thread;
+	return p ? p : &psicro_profili[PSICRO_PREC];
+}
+
+// --- STATO DEI SOLUTORI E BUDGET DI VALUTAZIONE ---
+// Ogni ciclo iterativo ha un limite fisso di iterazioni, quindi ogni chiamata
+// ha un numero massimo di valutazioni del modello noto a priori (le funzioni
+// composte chiamano al più tre solutori). Quando un solutore esaurisce il
+// limite o non trova soluzione lo segnala nello stato del thread, che le
+// funzioni esportate azzerano all'ingresso: psicro_stato() dopo una chiamata
+// dice se il valore restituito è affidabile.
+#define PSICRO_STATO_OK          0
+#define PSICRO_STATO_NON_CONV    1   // Limite di iterazioni raggiunto senza convergenza
+#define PSICRO_STATO_NO_SOL      2   // Nessuna soluzione nel campo di ricerca (valore -999)
+#define PSICRO_MAX_ITER_BISEZ    200 // Limite di t_ur_tbu (espansioni + bisezioni)
+#define PSICRO_BUDGET_CHIAMATA   600 // Valutazioni massime per chiamata (somma dei limiti di una catena di solutori)
+
+typedef struct {
+	int stato;          // OR dei PSICRO_STATO_*
+	int valutazioni;    // Valutazioni del modello nei solutori
+} psicro_contesto;
+
+extern PSICRO_TLS psicro_contesto psicro_ctx;
+
+PSICRO_INLINE void psicro_ctx_avvia(void) {
+	psicro_ctx.stato = PSICRO_STATO_OK;
+	psicro_ctx.valutazioni = 0;
+}
+// Un accesso al TLS per chiamata di solutore, non per iterazione; il contatore
+// satura a INT_MAX. Le unità che chiamano il nucleo in ciclo senza esporre lo
+// stato (batch, motori) definiscono PSICRO_SENZA_CONTEGGIO prima degli
+// include: il conteggio sparisce e i cicli non toccano il TLS.
+PSICRO_INLINE void psicro_ctx_conta(int n_eval, int stato) {
+#ifdef PSICRO_SENZA_CONTEGGIO
+	(void)n_eval;
+	(void)stato;
+#else
+	psicro_contesto* c = &psicro_ctx;
+	c->valutazioni = (n_eval > INT_MAX - c->valutazioni) ? INT_MAX : c->valutazioni + n_eval;
+	c->stato |= stato;
+#endif
+}
+
+// Stato e valutazioni dell'ultima chiamata esportata del thread (le funzioni
+// batch non li modificano, tranne psicro_batch_stato)
+PSICRO_EXPORT int PSICRO_CALL psicro_stato(void);
+PSICRO_EXPORT int PSICRO_CALL psicro_valutazioni(void);
+
+// Come psicro_batch con lo stato di ogni riga in stato[i] (PSICRO_STATO_*)
+PSICRO_EXPORT int PSICRO_CALL psicro_batch_stato(int target, int id1, const double* v1, int id2, const double* v2,
+	long long n, double* out, unsigned char* stato);
+
+// Profilo di processo; restituisce il precedente o PSICRO_ERR_ARG
+PSICRO_EXPORT int PSICRO_CALL psicro_set_precisione(int profilo);
+// Profilo del solo thread chiamante (-1 = torna a quello di processo); restituisce il precedente (-1 se nessuno)
+PSICRO_EXPORT int PSICRO_CALL psicro_set_precisione_thread(int profilo);
+// Come psicro_calc / psicro_batch con un profilo per la sola chiamata
+PSICRO_EXPORT double PSICRO_CALL psicro_calc_prec(int target, int id1, double v1, int id2, double v2, int profilo);
+PSICRO_EXPORT int PSICRO_CALL psicro_batch_prec(int target, int id1, const double* v1, int id2, const double* v2,
+	long long n, int profilo, double* out);
+
+#endif
@@ -0,0 +1,331 @@
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicro_regioni.h"
+#include "psicro_core.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define X_INF        1e30    // Nessun limite (finito: l'interpolazione non produce NaN)
+#define CELLA_T      0.5     // Larghezza delle celle dell'indice [K]
+#define N_CELLE_X    128
+#define MAX_CELLE_T  1024
+
+// --- REGIONE NEL PIANO (t, x) ---
+typedef struct {
+    int vuota;
+    double t_lo, t_hi;
+    double inv_dt;
+    int n_tab;                   // Nodi t_lo + k * PSICRO_REG_PASSO_T (>= 2)
+    double* x_lo;
+    double* x_hi;
+    int n_semi;                  // Semipiani a*t + b*x <= c (lati del poligono)
+    double a[PSICRO_REG_MAX_VERTICI], b[PSICRO_REG_MAX_VERTICI], c[PSICRO_REG_MAX_VERTICI];
+} regione_tx;
+
+struct psicro_classificatore {
+    int n_reg;
+    regione_tx reg[PSICRO_REG_MAX_REGIONI];
+    unsigned int tutte;          // Maschera delle regioni non vuote
+    // Indice: celle [g_t0 + i * g_dt, +g_dt) x [g_x0 + j * g_dx, +g_dx)
+    double g_t0, g_x0, g_dt, g_dx, g_inv_dt, g_inv_dx;
+    int g_nt, g_nx;
+    unsigned int* dentro;        // Regioni che contengono tutta la cella
+    unsigned int* bordo;         // Regioni da provare punto per punto
+};
+
+static double interp(const double* tab, const regione_tx* R, double t) {
+    double u = (t - R->t_lo) * R->inv_dt;
+    int k = (int)u;
+    if (k < 0) k = 0;
+    if (k > R->n_tab - 2) k = R->n_tab - 2;
+    double f = u - (double)k;
+    return tab[k] + f * (tab[k + 1] - tab[k]);
+}
+
+static int contiene(const regione_tx* R, double t, double x) {
+    if (!(t >= R->t_lo && t <= R->t_hi)) return 0;
+    if (!(x >= interp(R->x_lo, R, t) && x <= interp(R->x_hi, R, t))) return 0;
+    for (int e = 0; e < R->n_semi; e++) {
+        if (R->a[e] * t + R->b[e] * x > R->c[e]) return 0;
+    }
+    return 1;
+}
+
+// Titolo sul limite 'id = v' alla temperatura t. Con ur e tr un titolo negativo
+// vuol dire pv >= patm (nessuno stato sotto, limite superiore assente): X_INF.
+// Con h, vau e tbu un titolo negativo è un limite valido (sotto l'aria secca).
+static double x_limite(int id, double t, double v, double patm) {
+    core_termini_t k;
+    core_termini(id, t, v, &k);
+    double x = core_x_coppia_t(id, t, v, &k, patm);
+    if (!isfinite(x)) return X_INF;
+    if ((id == PSICRO_UR || id == PSICRO_TR) && x < 0.0) return X_INF;
+    return x;
+}
+
+// Coordinate (t, x) di un vertice dato in una coppia qualsiasi
+static int vertice_tx(const psicro_vertice* v, double* t, double* x) {
+    if (v->id1 < 0 || v->id1 >= PSICRO_N_PROP || v->id2 < 0 || v->id2 >= PSICRO_N_PROP || v->id1 == v->id2) return 0;
+    *t = psicro_calc(PSICRO_T, v->id1, v->v1, v->id2, v->v2);
+    *x = psicro_calc(PSICRO_X, v->id1, v->v1, v->id2, v->v2);
+    return isfinite(*t) && isfinite(*x) && *t > -273.15;
+}
+
+static int converti(const psicro_regione* src, double patm, regione_tx* R) {
+    memset(R, 0, sizeof(*R));
+    double t_lo = isnan(src->min[PSICRO_T]) ? -X_INF : src->min[PSICRO_T];
+    double t_hi = isnan(src->max[PSICRO_T]) ? X_INF : src->max[PSICRO_T];
+    // Poligono: semipiani con orientamento dato dall'area con segno
+    int nv = src->n_vertici;
+    if (nv != 0 && (nv < 3 || nv > PSICRO_REG_MAX_VERTICI)) return PSICRO_ERR_ARG;
+    if (nv > 0) {
+        double vt[PSICRO_REG_MAX_VERTICI], vx[PSICRO_REG_MAX_VERTICI];
+        double area = 0.0, p_lo = X_INF, p_hi = -X_INF;
+        for (int i = 0; i < nv; i++) {
+            if (!vertice_tx(&src->vertici[i], &vt[i], &vx[i])) return PSICRO_ERR_ARG;
+            if (vt[i] < p_lo) p_lo = vt[i];
+            if (vt[i] > p_hi) p_hi = vt[i];
+        }
+        for (int i = 0; i < nv; i++) {
+            int j = (i + 1) % nv;
+            area += vt[i] * vx[j] - vt[j] * vx[i];
+        }
+        if (area == 0.0) return PSICRO_ERR_ARG;
+        double verso = (area > 0.0) ? 1.0 : -1.0;
+        for (int i = 0; i < nv; i++) {
+            int j = (i + 1) % nv, l = (i + 2) % nv;
+            // Convessità: ogni svolta nello stesso verso
+            double svolta = (vt[j] - vt[i]) * (vx[l] - vx[j]) - (vx[j] - vx[i]) * (vt[l] - vt[j]);
+            if (svolta * verso < 0.0) return PSICRO_ERR_ARG;
+            R->a[i] = verso * (vx[j] - vx[i]);
+            R->b[i] = -verso * (vt[j] - vt[i]);
+            R->c[i] = R->a[i] * vt[i] + R->b[i] * vx[i];
+        }
+        R->n_semi = nv;
+        if (p_lo > t_lo) t_lo = p_lo;
+        if (p_hi < t_hi) t_hi = p_hi;
+    }
+    if (t_lo <= -X_INF) t_lo = PSICRO_REG_T_MIN;
+    if (t_hi >= X_INF) t_hi = PSICRO_REG_T_MAX;
+    R->t_lo = t_lo;
+    R->t_hi = t_hi;
+    if (!(t_hi >= t_lo)) {
+        R->vuota = 1;
+        return PSICRO_OK;
+    }
+    // Tabelle x_min(t), x_max(t): intersezione di tutti i limiti
+    R->n_tab = (int)ceil((t_hi - t_lo) / PSICRO_REG_PASSO_T) + 2;
+    R->inv_dt = 1.0 / PSICRO_REG_PASSO_T;
+    R->x_lo = (double*)malloc((size_t)R->n_tab * sizeof(double));
+    R->x_hi = (double*)malloc((size_t)R->n_tab * sizeof(double));
+    if (!R->x_lo || !R->x_hi) return PSICRO_ERR_MEM;
+    for (int k = 0; k < R->n_tab; k++) {
+        double t = t_lo + k * PSICRO_REG_PASSO_T;
+        double xl = -X_INF, xh = X_INF;
+        for (int id = 1; id < PSICRO_N_PROP; id++) {
+            if (!isnan(src->min[id])) {
+                double v = x_limite(id, t, src->min[id], patm);
+                if (v > xl) xl = v;
+            }
+            if (!isnan(src->max[id])) {
+                double v = x_limite(id, t, src->max[id], patm);
+                if (v < xh) xh = v;
+            }
+        }
+        R->x_lo[k] = xl;
+        R->x_hi[k] = xh;
+    }
+    return PSICRO_OK;
+}
+
+// --- INDICE A CELLE ---
+// Estremi di una tabella su [ta, tb]: agli estremi e ai nodi interni
+static void estremi(const double* tab, const regione_tx* R, double ta, double tb, double* mn, double* mx) {
+    double va = interp(tab, R, ta), vb = interp(tab, R, tb);
+    *mn = (va < vb) ? va : vb;
+    *mx = (va > vb) ? va : vb;
+    int k0 = (int)ceil((ta - R->t_lo) * R->inv_dt), k1 = (int)floor((tb - R->t_lo) * R->inv_dt);
+    if (k0 < 0) k0 = 0;
+    if (k1 > R->n_tab - 1) k1 = R->n_tab - 1;
+    for (int k = k0; k <= k1; k++) {
+        if (tab[k] < *mn) *mn = tab[k];
+        if (tab[k] > *mx) *mx = tab[k];
+    }
+}
+
+// 1: cella tutta dentro, 0: tutta fuori, -1: bordo
+static int stato_cella(const regione_tx* R, double ta, double tb, double xa, double xb) {
+    if (tb < R->t_lo || ta > R->t_hi) return 0;
+    double sa = (ta > R->t_lo) ? ta : R->t_lo, sb = (tb < R->t_hi) ? tb : R->t_hi;
+    double lo_min, lo_max, hi_min, hi_max;
+    estremi(R->x_lo, R, sa, sb, &lo_min, &lo_max);
+    estremi(R->x_hi, R, sa, sb, &hi_min, &hi_max);
+    if (xa > hi_max || xb < lo_min) return 0;
+    int dentro = (ta >= R->t_lo && tb <= R->t_hi && xa >= lo_max && xb <= hi_min);
+    for (int e = 0; e < R->n_semi; e++) {
+        int ok = 0;
+        ok += (R->a[e] * ta + R->b[e] * xa <= R->c[e]);
+        ok += (R->a[e] * ta + R->b[e] * xb <= R->c[e]);
+        ok += (R->a[e] * tb + R->b[e] * xa <= R->c[e]);
+        ok += (R->a[e] * tb + R->b[e] * xb <= R->c[e]);
+        if (ok == 0) return 0;
+        if (ok < 4) dentro = 0;
+    }
+    return dentro ? 1 : -1;
+}
+
+static int costruisci_indice(psicro_classificatore* c) {
+    double t0 = X_INF, t1 = -X_INF, x1 = 0.0;
+    for (int r = 0; r < c->n_reg; r++) {
+        const regione_tx* R = &c->reg[r];
+        if (R->vuota) continue;
+        if (R->t_lo < t0) t0 = R->t_lo;
+        if (R->t_hi > t1) t1 = R->t_hi;
+        for (int k = 0; k < R->n_tab; k++) {
+            if (R->x_hi[k] < X_INF && R->x_hi[k] > x1) x1 = R->x_hi[k];
+        }
+    }
+    if (t0 > t1) return PSICRO_OK;           // Nessuna regione non vuota: niente indice
+    if (x1 <= 0.0 || x1 > 0.1) x1 = 0.1;     // Regioni aperte verso l'alto: fino a 0,1 kg/kg
+    c->g_nt = (int)ceil((t1 - t0) / CELLA_T);
+    if (c->g_nt < 1) c->g_nt = 1;
+    if (c->g_nt > MAX_CELLE_T) c->g_nt = MAX_CELLE_T;
+    c->g_nx = N_CELLE_X;
+    c->g_t0 = t0;
+    c->g_x0 = 0.0;
+    c->g_dt = (t1 - t0) / c->g_nt;
+    if (c->g_dt <= 0.0) c->g_dt = CELLA_T;
+    c->g_dx = x1 / c->g_nx;
+    c->g_inv_dt = 1.0 / c->g_dt;
+    c->g_inv_dx = 1.0 / c->g_dx;
+    size_t n_celle = (size_t)c->g_nt * c->g_nx;
+    c->dentro = (unsigned int*)calloc(n_celle, sizeof(unsigned int));
+    c->bordo = (unsigned int*)calloc(n_celle, sizeof(unsigned int));
+    if (!c->dentro || !c->bordo) return PSICRO_ERR_MEM;
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < c->g_nt; i++) {
+        double ta = c->g_t0 + i * c->g_dt, tb = ta + c->g_dt;
+        for (int j = 0; j < c->g_nx; j++) {
+            double xa = c->g_x0 + j * c->g_dx, xb = xa + c->g_dx;
+            unsigned int d = 0, b = 0;
+            for (int r = 0; r < c->n_reg; r++) {
+                if (c->reg[r].vuota) continue;
+                int s = stato_cella(&c->reg[r], ta, tb, xa, xb);
+                if (s > 0) d |= 1u << r;
+                else if (s < 0) b |= 1u << r;
+            }
+            c->dentro[(size_t)i * c->g_nx + j] = d;
+            c->bordo[(size_t)i * c->g_nx + j] = b;
+        }
+    }
+    return PSICRO_OK;
+}
+
+PSICRO_EXPORT void PSICRO_CALL psicro_regione_vuota(psicro_regione* r) {
+    if (!r) return;
+    memset(r, 0, sizeof(*r));
+    for (int id = 0; id < PSICRO_N_PROP; id++) {
+        r->min[id] = NAN;
+        r->max[id] = NAN;
+    }
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_regione_predefinita(int tipo, psicro_regione* r) {
+    if (!r) return PSICRO_ERR_ARG;
+    psicro_regione_vuota(r);
+    switch (tipo) {
+    case PSICRO_REG_DC_RACCOMANDATO:
+        r->min[PSICRO_T] = 18.0;  r->max[PSICRO_T] = 27.0;
+        r->min[PSICRO_TR] = -9.0; r->max[PSICRO_TR] = 15.0;
+        r->max[PSICRO_UR] = 60.0;
+        return PSICRO_OK;
+    case PSICRO_REG_DC_A1:
+        r->min[PSICRO_T] = 15.0;   r->max[PSICRO_T] = 32.0;
+        r->min[PSICRO_TR] = -12.0; r->max[PSICRO_TR] = 17.0;
+        r->min[PSICRO_UR] = 8.0;   r->max[PSICRO_UR] = 80.0;
+        return PSICRO_OK;
+    default:
+        return PSICRO_ERR_NON_SUPP;
+    }
+}
+
+PSICRO_EXPORT void PSICRO_CALL psicro_classificatore_libera(psicro_classificatore* c) {
+    if (!c) return;
+    for (int r = 0; r < c->n_reg; r++) {
+        free(c->reg[r].x_lo);
+        free(c->reg[r].x_hi);
+    }
+    free(c->dentro);
+    free(c->bordo);
+    free(c);
+}
+
+PSICRO_EXPORT psicro_classificatore* PSICRO_CALL psicro_classificatore_crea(const psicro_regione* regioni, int n_regioni) {
+    if (!regioni || n_regioni <= 0 || n_regioni > PSICRO_REG_MAX_REGIONI) return NULL;
+    psicro_classificatore* c = (psicro_classificatore*)calloc(1, sizeof(psicro_classificatore));
+    if (!c) return NULL;
+    const double p = PATM;
+    c->n_reg = n_regioni;
+    for (int r = 0; r < n_regioni; r++) {
+        if (converti(&regioni[r], p, &c->reg[r]) != PSICRO_OK) {
+            psicro_classificatore_libera(c);
+            return NULL;
+        }
+        if (!c->reg[r].vuota) c->tutte |= 1u << r;
+    }
+    if (costruisci_indice(c) != PSICRO_OK) {
+        psicro_classificatore_libera(c);
+        return NULL;
+    }
+    return c;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_classifica(const psicro_classificatore* c, const double* t, const double* x,
+    long long n, unsigned int* maschera, int* regione, long long* ore) {
+    if (!c || !t || !x || n <= 0) return PSICRO_ERR_ARG;
+    const int n_reg = c->n_reg;
+    if (ore) memset(ore, 0, (size_t)(n_reg + 1) * sizeof(long long));
+#pragma omp parallel
+    {
+        long long conta[PSICRO_REG_MAX_REGIONI + 1];
+        memset(conta, 0, sizeof(conta));
+#pragma omp for schedule(static)
+        for (long long i = 0; i < n; i++) {
+            double ti = t[i], xi = x[i];
+            unsigned int m = 0, prova = 0;
+            if (!isnan(ti) && !isnan(xi)) {
+                double u = (ti - c->g_t0) * c->g_inv_dt, v = (xi - c->g_x0) * c->g_inv_dx;
+                // L'indice copre in t tutte le regioni (estremo superiore incluso)
+                if (c->dentro && u >= 0.0 && u <= c->g_nt) {
+                    int it = (u < c->g_nt) ? (int)u : c->g_nt - 1;
+                    if (v >= 0.0 && v < c->g_nx) {
+                        size_t k = (size_t)it * c->g_nx + (size_t)(int)v;
+                        m = c->dentro[k];
+                        prova = c->bordo[k];
+                    }
+                    else {
+                        prova = c->tutte;   // Fuori dall'indice in x: prova esatta su tutte
+                    }
+                }
+                for (int r = 0; prova != 0; r++, prova >>= 1) {
+                    if ((prova & 1u) && contiene(&c->reg[r], ti, xi)) m |= 1u << r;
+                }
+            }
+            int primo = -1;
+            for (int r = 0; r < n_reg; r++) {
+                if (m & (1u << r)) {
+                    conta[r]++;
+                    if (primo < 0) primo = r;
+                }
+            }
+            if (m == 0) conta[n_reg]++;
+            if (maschera) maschera[i] = m;
+            if (regione) regione[i] = primo;
+        }
+        if (ore) {
+#pragma omp critical(psicro_regioni_ore)
+            for (int r = 0; r <= n_reg; r++) ore[r] += conta[r];
+        }
+    }
+    return PSICRO_OK;
+}
@@ -0,0 +1,61 @@
+#ifndef PSICRO_REGIONI_H
+#define PSICRO_REGIONI_H
+
+#include "psicrometria.h"
+
+// --- CLASSIFICAZIONE DI STATI IN REGIONI DEL DIAGRAMMA ---
+// Una regione è l'intersezione di limiti min/max su una o più grandezze
+// (t, ur, x, h, vau, tbu, tr: es. campi ASHRAE per data centre) e,
+// opzionalmente, di un poligono convesso i cui vertici si danno in qualsiasi
+// coppia di grandezze (es. zona di comfort ASHRAE 55, zone di economizzatore).
+//
+// psicro_classificatore_crea converte tutto una volta nel piano (t, x) alla
+// PATM corrente: i limiti diventano curve x_min(t), x_max(t) tabulate a passo
+// PSICRO_REG_PASSO_T, i lati del poligono semipiani. Sopra le regioni si
+// costruisce una griglia uniforme di celle che per ogni regione dice se la
+// cella è tutta dentro, tutta fuori o di bordo: la gran parte dei punti si
+// etichetta con una lettura, solo le regioni di bordo si provano punto per punto.
+// Se PATM cambia, il classificatore va ricreato.
+#define PSICRO_REG_MAX_REGIONI   32     // Una regione per bit della maschera
+#define PSICRO_REG_MAX_VERTICI   16
+#define PSICRO_REG_PASSO_T       0.05   // Passo delle tabelle x(t) [K]
+#define PSICRO_REG_T_MIN        -50.0   // Campo di t per regioni senza limiti di t [°C]
+#define PSICRO_REG_T_MAX        100.0
+
+// Regioni predefinite (psicro_regione_predefinita)
+#define PSICRO_REG_DC_RACCOMANDATO  0   // Data centre, campo raccomandato: 18-27 °C, tr -9..15 °C, ur <= 60%
+#define PSICRO_REG_DC_A1            1   // Data centre, classe A1 ammessa: 15-32 °C, tr -12..17 °C, ur 8..80%
+
+typedef struct {
+	int id1;
+	double v1;
+	int id2;
+	double v2;
+} psicro_vertice;
+
+typedef struct {
+	double min[PSICRO_N_PROP];   // Limite inferiore per grandezza (NaN = nessuno)
+	double max[PSICRO_N_PROP];   // Limite superiore per grandezza (NaN = nessuno)
+	int n_vertici;               // 0 = nessun poligono, altrimenti 3 .. PSICRO_REG_MAX_VERTICI
+	psicro_vertice vertici[PSICRO_REG_MAX_VERTICI];
+} psicro_regione;
+
+typedef struct psicro_classificatore psicro_classificatore;
+
+// Regione senza limiti (tutti NaN, nessun poligono)
+PSICRO_EXPORT void PSICRO_CALL psicro_regione_vuota(psicro_regione* r);
+PSICRO_EXPORT int PSICRO_CALL psicro_regione_predefinita(int tipo, psicro_regione* r);
+
+// NULL se gli argomenti non sono validi (poligono non convesso, vertici non convertibili ...)
+PSICRO_EXPORT psicro_classificatore* PSICRO_CALL psicro_classificatore_crea(const psicro_regione* regioni, int n_regioni);
+PSICRO_EXPORT void PSICRO_CALL psicro_classificatore_libera(psicro_classificatore* c);
+
+// Etichetta n stati (t [°C], x [kg/kg]).
+// maschera: (opz.) bit r acceso se lo stato è nella regione r
+// regione:  (opz.) prima regione che contiene lo stato, -1 se nessuna
+// ore:      (opz.) n_regioni + 1 contatori (l'ultimo: stati fuori da tutte), azzerati e riempiti
+// Stati con t o x NaN non appartengono a nessuna regione.
+PSICRO_EXPORT int PSICRO_CALL psicro_classifica(const psicro_classificatore* c, const double* t, const double* x,
+	long long n, unsigned int* maschera, int* regione, long long* ore);
+
+#endif
@@ -0,0 +1,407 @@
+#ifndef _WIN32
+#include "psicro_service.h"
+#include "psicro_thread.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#define RIGHE_TASK     16384        // Righe per task del pool
+#define CACHE_BIT      20           // 2^20 voci
+#define CACHE_STRISCE  256          // Lock a strisce sulla cache
+
+// --- CACHE DEI RISULTATI (a indirizzamento diretto) ---
+typedef struct {
+    int32_t chiave_fn;              // target*100 + id1*10 + id2 + 1, 0 = vuota
+    double v1, v2, patm, val;
+} voce_cache;
+
+static voce_cache* cache;
+static psicro_mutex strisce[CACHE_STRISCE];
+
+static size_t cache_indice(int32_t fn, double v1, double v2, double patm) {
+    uint64_t a, b, c;
+    memcpy(&a, &v1, 8);
+    memcpy(&b, &v2, 8);
+    memcpy(&c, &patm, 8);
+    // Mescolamento tipo splitmix64: i double "tondi" hanno molti bit bassi a zero
+    uint64_t h = a ^ (b * 0x9E3779B97F4A7C15ull) ^ (c * 0xC2B2AE3D27D4EB4Full) ^ (uint64_t)fn;
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return (size_t)(h >> (64 - CACHE_BIT));
+}
+static int cache_leggi(int32_t fn, double v1, double v2, double patm, double* val) {
+    size_t k = cache_indice(fn, v1, v2, patm);
+    int trovato = 0;
+    psicro_mutex_lock(&strisce[k % CACHE_STRISCE]);
+    const voce_cache* e = &cache[k];
+    if (e->chiave_fn == fn && e->v1 == v1 && e->v2 == v2 && e->patm == patm) {
+        *val = e->val;
+        trovato = 1;
+    }
+    psicro_mutex_unlock(&strisce[k % CACHE_STRISCE]);
+    return trovato;
+}
+static void cache_scrivi(int32_t fn, double v1, double v2, double patm, double val) {
+    size_t k = cache_indice(fn, v1, v2, patm);
+    psicro_mutex_lock(&strisce[k % CACHE_STRISCE]);
+    voce_cache* e = &cache[k];
+    e->chiave_fn = fn;
+    e->v1 = v1;
+    e->v2 = v2;
+    e->patm = patm;
+    e->val = val;
+    psicro_mutex_unlock(&strisce[k % CACHE_STRISCE]);
+}
+
+// --- CONNESSIONI E RICHIESTE ---
+typedef struct connessione {
+    int fd;
+    uint32_t n_slot, righe_slot;
+    char* base;                     // Regione condivisa mappata
+    size_t dim;
+    int in_volo;                    // Task non ancora completati
+    psicro_mutex mtx;
+    psicro_cond cnd;
+    struct connessione* succ;       // Elenco delle connessioni aperte
+} connessione;
+
+typedef struct {
+    connessione* conn;
+    psicro_svc_req req;
+    int task_mancanti;
+    int stato;
+    int64_t da_cache;
+} richiesta;
+
+typedef struct task {
+    richiesta* r;
+    int64_t i0, n;
+    struct task* succ;
+} task;
+
+static psicro_mutex mtx_coda = PSICRO_MUTEX_INIT;
+static psicro_cond cnd_coda;
+static task* coda_testa;
+static task* coda_fondo;
+static unsigned long long fermo;    // Niente nuove connessioni né richieste (psicro_atomica_*)
+static int pool_fermo;              // I lavoratori escono a coda vuota (sotto mtx_coda)
+static int fd_ascolto = -1;         // Sotto mtx_conn
+
+// Connessioni aperte: all'arresto si chiude la lettura e si attende che
+// ciascuna abbia completato i propri task, prima di fermare il pool
+static psicro_mutex mtx_conn = PSICRO_MUTEX_INIT;
+static psicro_cond cnd_conn;
+static connessione* connessioni;
+static int n_connessioni;
+
+static void accoda(task* t) {
+    psicro_mutex_lock(&mtx_coda);
+    t->succ = NULL;
+    if (coda_fondo) coda_fondo->succ = t;
+    else coda_testa = t;
+    coda_fondo = t;
+    psicro_cond_broadcast(&cnd_coda);
+    psicro_mutex_unlock(&mtx_coda);
+}
+
+static int scrivi_tutto(int fd, const void* buf, size_t n) {
+    const char* p = (const char*)buf;
+    while (n > 0) {
+        ssize_t k = send(fd, p, n, MSG_NOSIGNAL);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return -1;
+        p += k;
+        n -= (size_t)k;
+    }
+    return 0;
+}
+static int leggi_tutto(int fd, void* buf, size_t n) {
+    char* p = (char*)buf;
+    while (n > 0) {
+        ssize_t k = recv(fd, p, n, 0);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return -1;
+        p += k;
+        n -= (size_t)k;
+    }
+    return 0;
+}
+
+static void esegui_task(task* t) {
+    richiesta* r = t->r;
+    connessione* c = r->conn;
+    const psicro_svc_req* q = &r->req;
+    double* v1 = (double*)(c->base + PSICRO_SVC_SLOT_BYTE(c->righe_slot) * q->slot);
+    double* v2 = v1 + c->righe_slot;
+    double* out = v2 + c->righe_slot;
+    const double p = (q->patm > 0.0) ? q->patm : PATM;
+    int64_t da_cache = 0;
+
+    if (q->target == PSICRO_TBU || q->target == PSICRO_TR) {
+        // Target iterativi: si passa dalla cache riga per riga
+        const int32_t fn = q->target * 100 + q->id1 * 10 + q->id2 + 1;
+        for (int64_t i = t->i0; i < t->i0 + t->n; i++) {
+            if (cache_leggi(fn, v1[i], v2[i], p, &out[i])) {
+                da_cache++;
+                continue;
+            }
+            psicro_batch_blocco(q->target, q->id1, v1 + i, q->id2, v2 + i, 1, p, out + i);
+            cache_scrivi(fn, v1[i], v2[i], p, out[i]);
+        }
+    }
+    else {
+        psicro_batch_blocco(q->target, q->id1, v1 + t->i0, q->id2, v2 + t->i0, t->n, p, out + t->i0);
+    }
+
+    psicro_mutex_lock(&c->mtx);
+    r->da_cache += da_cache;
+    int ultimo = (--r->task_mancanti == 0);
+    if (ultimo) {
+        psicro_svc_resp resp;
+        resp.slot = q->slot;
+        resp.stato = r->stato;
+        resp.da_cache = r->da_cache;
+        scrivi_tutto(c->fd, &resp, sizeof(resp));
+        free(r);
+    }
+    c->in_volo--;
+    psicro_cond_broadcast(&c->cnd);
+    psicro_mutex_unlock(&c->mtx);
+    free(t);
+}
+
+static psicro_thread_ret PSICRO_THREAD_FN lavoratore(void* arg) {
+    (void)arg;
+    for (;;) {
+        psicro_mutex_lock(&mtx_coda);
+        while (coda_testa == NULL && !pool_fermo) psicro_cond_wait(&cnd_coda, &mtx_coda, 200);
+        if (coda_testa == NULL) {
+            psicro_mutex_unlock(&mtx_coda);
+            return 0;
+        }
+        task* t = coda_testa;
+        coda_testa = t->succ;
+        if (coda_testa == NULL) coda_fondo = NULL;
+        psicro_mutex_unlock(&mtx_coda);
+        esegui_task(t);
+    }
+}
+
+static void rispondi_errore(connessione* c, uint32_t slot, int stato) {
+    psicro_svc_resp resp;
+    resp.slot = slot;
+    resp.stato = stato;
+    resp.da_cache = 0;
+    psicro_mutex_lock(&c->mtx);
+    scrivi_tutto(c->fd, &resp, sizeof(resp));
+    psicro_mutex_unlock(&c->mtx);
+}
+
+static int valida(const connessione* c, const psicro_svc_req* q) {
+    if (q->slot >= c->n_slot || q->n <= 0 || q->n > (int64_t)c->righe_slot || q->id1 == q->id2) return PSICRO_ERR_ARG;
+    if (q->id1 < 0 || q->id1 >= PSICRO_N_PROP || q->id2 < 0 || q->id2 >= PSICRO_N_PROP ||
+        q->target < 0 || q->target >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+    if (q->target != q->id1 && q->target != q->id2 && psicro_funzione(q->target, q->id1, q->id2) == NULL) return PSICRO_ERR_NON_SUPP;
+    return PSICRO_OK;
+}
+
+static psicro_thread_ret PSICRO_THREAD_FN gestisci_connessione(void* arg) {
+    connessione* c = (connessione*)arg;
+    psicro_svc_hello hello;
+    int shm_fd = -1;
+    if (leggi_tutto(c->fd, &hello, sizeof(hello)) != 0 || hello.magic != PSICRO_SVC_MAGIC ||
+        hello.versione != PSICRO_SVC_VERSIONE || hello.n_slot == 0 || hello.n_slot > PSICRO_SVC_MAX_SLOT ||
+        hello.righe_slot == 0) goto fine;
+    hello.shm[sizeof(hello.shm) - 1] = '\0';
+    c->n_slot = hello.n_slot;
+    c->righe_slot = hello.righe_slot;
+    c->dim = PSICRO_SVC_SLOT_BYTE(c->righe_slot) * c->n_slot;
+    // Solo regioni del protocollo, e almeno grandi quanto dichiarato: una
+    // regione più corta darebbe SIGBUS al primo accesso oltre la fine
+    if (strncmp(hello.shm, PSICRO_SVC_SHM, strlen(PSICRO_SVC_SHM)) != 0 || strchr(hello.shm + 1, '/') != NULL) goto fine;
+    shm_fd = shm_open(hello.shm, O_RDWR, 0600);
+    if (shm_fd < 0) goto fine;
+    struct stat st;
+    if (fstat(shm_fd, &st) != 0 || st.st_size < 0 || (size_t)st.st_size < c->dim) {
+        close(shm_fd);
+        goto fine;
+    }
+    c->base = (char*)mmap(NULL, c->dim, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    close(shm_fd);
+    if (c->base == MAP_FAILED) {
+        c->base = NULL;
+        goto fine;
+    }
+    int32_t ok = PSICRO_OK;
+    if (scrivi_tutto(c->fd, &ok, sizeof(ok)) != 0) goto fine;
+
+    psicro_svc_req q;
+    while (!psicro_atomica_leggi(&fermo) && leggi_tutto(c->fd, &q, sizeof(q)) == 0) {
+        int stato = valida(c, &q);
+        if (stato != PSICRO_OK) {
+            rispondi_errore(c, q.slot, stato);
+            continue;
+        }
+        int n_task = (int)((q.n + RIGHE_TASK - 1) / RIGHE_TASK);
+        richiesta* r = (richiesta*)calloc(1, sizeof(richiesta));
+        if (r == NULL) {
+            rispondi_errore(c, q.slot, PSICRO_ERR_MEM);
+            continue;
+        }
+        r->conn = c;
+        r->req = q;
+        r->task_mancanti = n_task;
+        r->stato = PSICRO_OK;
+        psicro_mutex_lock(&c->mtx);
+        c->in_volo += n_task;
+        psicro_mutex_unlock(&c->mtx);
+        for (int k = 0; k < n_task; k++) {
+            task* t = (task*)malloc(sizeof(task));
+            if (t == NULL) {
+                // Il task mancante si chiude qui per non bloccare la risposta
+                psicro_mutex_lock(&c->mtx);
+                r->stato = PSICRO_ERR_MEM;
+                c->in_volo--;
+                int ultimo = (--r->task_mancanti == 0);
+                psicro_mutex_unlock(&c->mtx);
+                if (ultimo) {
+                    rispondi_errore(c, q.slot, PSICRO_ERR_MEM);
+                    free(r);
+                }
+                continue;
+            }
+            t->r = r;
+            t->i0 = (int64_t)k * RIGHE_TASK;
+            t->n = (t->i0 + RIGHE_TASK < q.n) ? RIGHE_TASK : q.n - t->i0;
+            accoda(t);
+        }
+    }
+
+fine:
+    // Si attende la fine dei task in volo prima di togliere la mappatura
+    psicro_mutex_lock(&c->mtx);
+    while (c->in_volo > 0) psicro_cond_wait(&c->cnd, &c->mtx, -1);
+    psicro_mutex_unlock(&c->mtx);
+    if (c->base) munmap(c->base, c->dim);
+    psicro_mutex_lock(&mtx_conn);
+    for (connessione** pc = &connessioni; *pc; pc = &(*pc)->succ) {
+        if (*pc == c) {
+            *pc = c->succ;
+            break;
+        }
+    }
+    n_connessioni--;
+    psicro_cond_broadcast(&cnd_conn);
+    psicro_mutex_unlock(&mtx_conn);
+    close(c->fd);
+    psicro_mutex_destroy(&c->mtx);
+    psicro_cond_destroy(&c->cnd);
+    free(c);
+    return 0;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_service_avvia(const char* socket_path, int n_thread) {
+    if (socket_path == NULL) socket_path = PSICRO_SVC_SOCKET;
+    if (n_thread <= 0) n_thread = psicro_numero_cpu();
+    cache = (voce_cache*)calloc((size_t)1 << CACHE_BIT, sizeof(voce_cache));
+    if (cache == NULL) return PSICRO_ERR_MEM;
+    for (int i = 0; i < CACHE_STRISCE; i++) psicro_mutex_init(&strisce[i]);
+    psicro_cond_init(&cnd_coda);
+    psicro_cond_init(&cnd_conn);
+    psicro_atomica_scrivi(&fermo, 0);
+    pool_fermo = 0;
+
+    struct sockaddr_un ind;
+    memset(&ind, 0, sizeof(ind));
+    ind.sun_family = AF_UNIX;
+    strncpy(ind.sun_path, socket_path, sizeof(ind.sun_path) - 1);
+    unlink(socket_path);
+    int ascolto = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (ascolto < 0 || bind(ascolto, (struct sockaddr*)&ind, sizeof(ind)) != 0 || listen(ascolto, 64) != 0) {
+        if (ascolto >= 0) close(ascolto);
+        free(cache);
+        return PSICRO_ERR_ARG;
+    }
+    psicro_mutex_lock(&mtx_conn);
+    fd_ascolto = ascolto;
+    psicro_mutex_unlock(&mtx_conn);
+
+    psicro_thread_t* pool = (psicro_thread_t*)calloc((size_t)n_thread, sizeof(psicro_thread_t));
+    int avviati = 0;
+    for (int i = 0; pool && i < n_thread; i++) {
+        if (psicro_thread_create(&pool[avviati], lavoratore, NULL)) avviati++;
+    }
+    int stato = (avviati > 0) ? PSICRO_OK : PSICRO_ERR_MEM;
+
+    while (stato == PSICRO_OK && !psicro_atomica_leggi(&fermo)) {
+        int fd = accept(ascolto, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            break;  // socket chiuso da psicro_service_ferma
+        }
+        connessione* c = (connessione*)calloc(1, sizeof(connessione));
+        psicro_thread_t th;
+        if (c == NULL) {
+            close(fd);
+            continue;
+        }
+        c->fd = fd;
+        psicro_mutex_init(&c->mtx);
+        psicro_cond_init(&c->cnd);
+        // Registrata prima dell'avvio: l'arresto la vede comunque
+        psicro_mutex_lock(&mtx_conn);
+        c->succ = connessioni;
+        connessioni = c;
+        n_connessioni++;
+        psicro_mutex_unlock(&mtx_conn);
+        if (!psicro_thread_create(&th, gestisci_connessione, c)) {
+            psicro_mutex_lock(&mtx_conn);
+            connessioni = c->succ;
+            n_connessioni--;
+            psicro_mutex_unlock(&mtx_conn);
+            close(fd);
+            psicro_mutex_destroy(&c->mtx);
+            psicro_cond_destroy(&c->cnd);
+            free(c);
+            continue;
+        }
+        pthread_detach(th);
+    }
+
+    // Arresto: prima le connessioni smettono di leggere richieste e attendono
+    // i propri task (il pool è ancora attivo), poi si ferma il pool
+    psicro_atomica_scrivi(&fermo, 1);
+    psicro_mutex_lock(&mtx_conn);
+    fd_ascolto = -1;
+    for (connessione* c = connessioni; c; c = c->succ) shutdown(c->fd, SHUT_RD);
+    while (n_connessioni > 0) psicro_cond_wait(&cnd_conn, &mtx_conn, 200);
+    psicro_mutex_unlock(&mtx_conn);
+    psicro_mutex_lock(&mtx_coda);
+    pool_fermo = 1;
+    psicro_cond_broadcast(&cnd_coda);
+    psicro_mutex_unlock(&mtx_coda);
+    for (int i = 0; i < avviati; i++) psicro_thread_join(pool[i]);
+    free(pool);
+    free(cache);
+    cache = NULL;
+    close(ascolto);
+    unlink(socket_path);
+    return stato;
+}
+
+PSICRO_EXPORT void PSICRO_CALL psicro_service_ferma(void) {
+    psicro_atomica_scrivi(&fermo, 1);
+    psicro_mutex_lock(&mtx_conn);
+    if (fd_ascolto >= 0) shutdown(fd_ascolto, SHUT_RDWR);
+    psicro_mutex_unlock(&mtx_conn);
+}
+
+#endif
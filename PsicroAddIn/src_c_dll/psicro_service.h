@@ -0,0 +1,66 @@
+#ifndef PSICRO_SERVICE_H
+#define PSICRO_SERVICE_H
+
+// --- SERVIZIO DI CALCOLO LOCALE (solo POSIX) ---
+// Un demone (src_service/psicrod.c) accetta richieste batch su un socket Unix.
+// Gli array non passano dal socket: il client crea una regione di memoria
+// condivisa (shm_open) divisa in n_slot slot ad anello, ciascuno con v1, v2 e
+// out da righe_slot valori; sul socket viaggiano solo i descrittori delle
+// richieste e delle risposte. Il server usa un unico pool di thread e una
+// cache dei risultati iterativi (tbu, tr) condivisi fra tutti i client.
+
+#include <stdint.h>
+#include "psicrometria.h"
+
+#define PSICRO_SVC_MAGIC     0x52435350u   // "PSCR"
+#define PSICRO_SVC_VERSIONE  1
+#define PSICRO_SVC_SOCKET    "/tmp/psicrod.sock"
+#define PSICRO_SVC_MAX_SLOT  64
+#define PSICRO_SVC_SHM       "/psicro"     // Prefisso obbligatorio dei nomi delle regioni
+
+// Messaggi sul socket
+typedef struct {
+	uint32_t magic, versione;
+	uint32_t n_slot, righe_slot;
+	char shm[64];                 // Nome della regione condivisa (shm_open)
+} psicro_svc_hello;
+
+typedef struct {
+	uint32_t slot;
+	int32_t target, id1, id2;     // Indici PSICRO_*
+	int64_t n;                    // Righe valide nello slot
+	double patm;                  // [kPa], <= 0 -> pressione del server (coppie con t)
+} psicro_svc_req;
+
+typedef struct {
+	uint32_t slot;
+	int32_t stato;                // PSICRO_OK o codice di errore
+	int64_t da_cache;             // Righe servite dalla cache
+} psicro_svc_resp;
+
+// Disposizione di uno slot nella regione condivisa
+#define PSICRO_SVC_SLOT_BYTE(righe)  ((size_t)(righe) * 3 * sizeof(double))
+
+// --- SERVER ---
+// Blocca finché non viene chiamato psicro_service_ferma o si verifica un errore.
+PSICRO_EXPORT int PSICRO_CALL psicro_service_avvia(const char* socket_path, int n_thread);
+PSICRO_EXPORT void PSICRO_CALL psicro_service_ferma(void);
+
+// --- CLIENT ---
+typedef struct psicro_client psicro_client;
+
+PSICRO_EXPORT psicro_client* PSICRO_CALL psicro_client_apri(const char* socket_path, int n_slot, int righe_slot);
+PSICRO_EXPORT void PSICRO_CALL psicro_client_chiudi(psicro_client* c);
+// Accesso diretto agli array di uno slot (zero copie)
+PSICRO_EXPORT double* PSICRO_CALL psicro_client_v1(psicro_client* c, int slot);
+PSICRO_EXPORT double* PSICRO_CALL psicro_client_v2(psicro_client* c, int slot);
+PSICRO_EXPORT double* PSICRO_CALL psicro_client_out(psicro_client* c, int slot);
+// Invio asincrono di una richiesta sugli array già scritti nello slot
+PSICRO_EXPORT int PSICRO_CALL psicro_client_invia(psicro_client* c, int slot, int target, int id1, int id2, long long n, double patm);
+// Attende la prossima risposta; ritorna lo stato e lo slot completato
+PSICRO_EXPORT int PSICRO_CALL psicro_client_ricevi(psicro_client* c, int* slot);
+// Batch completo: copia a blocchi negli slot tenendo in volo tutti gli slot
+PSICRO_EXPORT int PSICRO_CALL psicro_client_batch(psicro_client* c, int target, int id1, const double* v1, int id2, const double* v2,
+	long long n, double patm, double* out);
+
+#endif
@@ -0,0 +1,43 @@
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicro_sweep.h"
+#include "psicro_core.h"
+#include <math.h>
+
+PSICRO_API psicro_patm_quota(double altitude) { return core_patm_quota(altitude); }
+
+PSICRO_EXPORT int PSICRO_CALL psicro_sweep_patm(int id2, const double* t, const double* v2, long long n,
+    const int* target, int n_target, const double* patm, int n_p, double* out) {
+    if (!t || !v2 || !target || !patm || !out || n <= 0 || n_target <= 0 || n_p <= 0) return PSICRO_ERR_ARG;
+    if (id2 < PSICRO_UR || id2 > PSICRO_TR) return PSICRO_ERR_NON_SUPP;
+    int serve_tr = 0;
+    for (int k = 0; k < n_target; k++) {
+        if (target[k] < 0 || target[k] >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+        if (target[k] == PSICRO_TR) serve_tr = 1;
+    }
+    const long long passo_riga = (long long)n_p * n_target;
+
+#pragma omp parallel for schedule(static)
+    for (long long i = 0; i < n; i++) {
+        double* o = out + i * passo_riga;
+        core_termini_t k;
+        core_termini(id2, t[i], v2[i], &k);   // una volta per riga
+        // Con tr il punto di rugiada è l'ingresso; con ur la pressione di vapore
+        // ur * Psat(t) non dipende da PATM, e le soglie sono quelle di tr_t_ur
+        double tr_riga = NAN;
+        if (serve_tr && id2 == PSICRO_TR) tr_riga = v2[i];
+        else if (serve_tr && id2 == PSICRO_UR) {
+            if (v2[i] <= 0.001) tr_riga = -273.15;
+            else if (fabs(v2[i] - 100.0) < 0.00001) tr_riga = t[i];
+            else tr_riga = core_TPsat((v2[i] / 100.0) * k.ps_t);
+        }
+        for (int j = 0; j < n_p; j++) {
+            double p = patm[j];
+            double x = core_x_coppia_t(id2, t[i], v2[i], &k, p);
+            for (int c = 0; c < n_target; c++) {
+                if (target[c] == PSICRO_TR && !isnan(tr_riga)) o[j * n_target + c] = tr_riga;
+                else o[j * n_target + c] = core_target_t_x(target[c], t[i], x, k.ps_t, p);
+            }
+        }
+    }
+    return PSICRO_OK;
+}
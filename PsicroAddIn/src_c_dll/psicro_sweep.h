@@ -0,0 +1,23 @@
+#ifndef PSICRO_SWEEP_H
+#define PSICRO_SWEEP_H
+
+#include "psicrometria.h"
+
+// --- VALUTAZIONE MULTI-QUOTA ---
+// Valuta un dataset (t, v2) su un vettore di pressioni in una sola passata.
+// I termini che dipendono solo dalla temperatura (Psat(t), Psat(v2), hw_bu)
+// si calcolano una volta per riga e si riusano per tutte le pressioni; anche
+// il punto di rugiada si riusa quando la pressione di vapore non cambia con
+// PATM (coppie t-ur e t-tr).
+//
+// id2:      grandezza nota insieme a t (PSICRO_UR, PSICRO_X, PSICRO_H, PSICRO_VAU, PSICRO_TBU, PSICRO_TR)
+// target:   n_target indici PSICRO_* da calcolare
+// patm:     n_p pressioni [kPa] (vedi psicro_patm_quota per convertire le quote)
+// out:      n * n_p * n_target valori, disposti [riga][pressione][target]
+PSICRO_EXPORT int PSICRO_CALL psicro_sweep_patm(int id2, const double* t, const double* v2, long long n,
+	const int* target, int n_target, const double* patm, int n_p, double* out);
+
+// Pressione atmosferica standard [kPa] alla quota [m], senza modificare PATM
+PSICRO_API psicro_patm_quota(double altitude);
+
+#endif
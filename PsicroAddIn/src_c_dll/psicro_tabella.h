@@ -0,0 +1,124 @@
+#ifndef PSICRO_TABELLA_H
+#define PSICRO_TABELLA_H
+
+// --- TABELLA DELLE FUNZIONI target_a_b ---
+// Una voce per funzione, con la coppia ordinata per indice come in
+// EseguiSwitchCalcolo: VOCE(target, id1, id2, nome, nucleo), dove nucleo è
+// NUCLEO_P se core_nome riceve la pressione e NUCLEO se non ne dipende.
+// Chi include la tabella definisce VOCE (e NUCLEO / NUCLEO_P) per generare
+// adattatori e righe di ricerca dalla stessa lista.
+#define PSICRO_TABELLA(VOCE) \
+	/* --- TEMPERATURA (T) --- */ \
+	VOCE(PSICRO_T, PSICRO_UR, PSICRO_X, t_ur_x, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_UR, PSICRO_H, t_ur_h, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_UR, PSICRO_VAU, t_ur_vau, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_UR, PSICRO_TBU, t_ur_tbu, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_UR, PSICRO_TR, t_ur_tr, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_X, PSICRO_H, t_x_h, NUCLEO) \
+	VOCE(PSICRO_T, PSICRO_X, PSICRO_VAU, t_x_vau, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_X, PSICRO_TBU, t_x_tbu, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_X, PSICRO_TR, t_x_tr, NUCLEO) \
+	VOCE(PSICRO_T, PSICRO_H, PSICRO_VAU, t_h_vau, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_H, PSICRO_TBU, t_h_tbu, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_H, PSICRO_TR, t_h_tr, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_VAU, PSICRO_TBU, t_vau_tbu, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_VAU, PSICRO_TR, t_vau_tr, NUCLEO_P) \
+	VOCE(PSICRO_T, PSICRO_TBU, PSICRO_TR, t_tbu_tr, NUCLEO_P) \
+	/* --- UMIDITÀ RELATIVA (UR) --- */ \
+	VOCE(PSICRO_UR, PSICRO_T, PSICRO_X, ur_t_x, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_T, PSICRO_H, ur_t_h, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_T, PSICRO_VAU, ur_t_vau, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_T, PSICRO_TBU, ur_t_tbu, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_T, PSICRO_TR, ur_t_tr, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_X, PSICRO_H, ur_x_h, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_X, PSICRO_VAU, ur_x_vau, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_X, PSICRO_TBU, ur_x_tbu, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_X, PSICRO_TR, ur_x_tr, NUCLEO) \
+	VOCE(PSICRO_UR, PSICRO_H, PSICRO_VAU, ur_h_vau, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_H, PSICRO_TBU, ur_h_tbu, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_H, PSICRO_TR, ur_h_tr, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_VAU, PSICRO_TBU, ur_vau_tbu, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_VAU, PSICRO_TR, ur_vau_tr, NUCLEO_P) \
+	VOCE(PSICRO_UR, PSICRO_TBU, PSICRO_TR, ur_tbu_tr, NUCLEO_P) \
+	/* --- TITOLO (X) --- */ \
+	VOCE(PSICRO_X, PSICRO_T, PSICRO_UR, x_t_ur, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_T, PSICRO_H, x_t_h, NUCLEO) \
+	VOCE(PSICRO_X, PSICRO_T, PSICRO_VAU, x_t_vau, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_T, PSICRO_TBU, x_t_tbu, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_T, PSICRO_TR, x_t_tr, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_UR, PSICRO_H, x_ur_h, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_UR, PSICRO_VAU, x_ur_vau, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_UR, PSICRO_TBU, x_ur_tbu, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_UR, PSICRO_TR, x_ur_tr, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_H, PSICRO_VAU, x_h_vau, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_H, PSICRO_TBU, x_h_tbu, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_H, PSICRO_TR, x_h_tr, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_VAU, PSICRO_TBU, x_vau_tbu, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_VAU, PSICRO_TR, x_vau_tr, NUCLEO_P) \
+	VOCE(PSICRO_X, PSICRO_TBU, PSICRO_TR, x_tbu_tr, NUCLEO_P) \
+	/* --- ENTALPIA (H) --- */ \
+	VOCE(PSICRO_H, PSICRO_T, PSICRO_UR, h_t_ur, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_T, PSICRO_X, h_t_x, NUCLEO) \
+	VOCE(PSICRO_H, PSICRO_T, PSICRO_VAU, h_t_vau, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_T, PSICRO_TBU, h_t_tbu, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_T, PSICRO_TR, h_t_tr, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_UR, PSICRO_X, h_ur_x, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_UR, PSICRO_VAU, h_ur_vau, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_UR, PSICRO_TBU, h_ur_tbu, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_UR, PSICRO_TR, h_ur_tr, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_X, PSICRO_VAU, h_x_vau, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_X, PSICRO_TBU, h_x_tbu, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_X, PSICRO_TR, h_x_tr, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_VAU, PSICRO_TBU, h_vau_tbu, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_VAU, PSICRO_TR, h_vau_tr, NUCLEO_P) \
+	VOCE(PSICRO_H, PSICRO_TBU, PSICRO_TR, h_tbu_tr, NUCLEO_P) \
+	/* --- VOLUME SPECIFICO (VAU) --- */ \
+	VOCE(PSICRO_VAU, PSICRO_T, PSICRO_UR, vau_t_ur, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_T, PSICRO_X, vau_t_x, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_T, PSICRO_H, vau_t_h, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_T, PSICRO_TBU, vau_t_tbu, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_T, PSICRO_TR, vau_t_tr, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_UR, PSICRO_X, vau_ur_x, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_UR, PSICRO_H, vau_ur_h, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_UR, PSICRO_TBU, vau_ur_tbu, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_UR, PSICRO_TR, vau_ur_tr, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_X, PSICRO_H, vau_x_h, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_X, PSICRO_TBU, vau_x_tbu, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_X, PSICRO_TR, vau_x_tr, NUCLEO) \
+	VOCE(PSICRO_VAU, PSICRO_H, PSICRO_TBU, vau_h_tbu, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_H, PSICRO_TR, vau_h_tr, NUCLEO_P) \
+	VOCE(PSICRO_VAU, PSICRO_TBU, PSICRO_TR, vau_tbu_tr, NUCLEO_P) \
+	/* --- BULBO UMIDO (TBU) --- */ \
+	VOCE(PSICRO_TBU, PSICRO_T, PSICRO_UR, tbu_t_ur, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_T, PSICRO_X, tbu_t_x, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_T, PSICRO_H, tbu_t_h, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_T, PSICRO_VAU, tbu_t_vau, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_T, PSICRO_TR, tbu_t_tr, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_UR, PSICRO_X, tbu_ur_x, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_UR, PSICRO_H, tbu_ur_h, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_UR, PSICRO_VAU, tbu_ur_vau, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_UR, PSICRO_TR, tbu_ur_tr, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_X, PSICRO_H, tbu_x_h, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_X, PSICRO_VAU, tbu_x_vau, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_X, PSICRO_TR, tbu_x_tr, NUCLEO) \
+	VOCE(PSICRO_TBU, PSICRO_H, PSICRO_VAU, tbu_h_vau, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_H, PSICRO_TR, tbu_h_tr, NUCLEO_P) \
+	VOCE(PSICRO_TBU, PSICRO_VAU, PSICRO_TR, tbu_vau_tr, NUCLEO_P) \
+	/* --- PUNTO DI RUGIADA (TR) --- */ \
+	VOCE(PSICRO_TR, PSICRO_T, PSICRO_UR, tr_t_ur, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_T, PSICRO_X, tr_t_x, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_T, PSICRO_H, tr_t_h, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_T, PSICRO_VAU, tr_t_vau, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_T, PSICRO_TBU, tr_t_tbu, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_UR, PSICRO_X, tr_ur_x, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_UR, PSICRO_H, tr_ur_h, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_UR, PSICRO_VAU, tr_ur_vau, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_UR, PSICRO_TBU, tr_ur_tbu, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_X, PSICRO_H, tr_x_h, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_X, PSICRO_VAU, tr_x_vau, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_X, PSICRO_TBU, tr_x_tbu, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_H, PSICRO_VAU, tr_h_vau, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_H, PSICRO_TBU, tr_h_tbu, NUCLEO_P) \
+	VOCE(PSICRO_TR, PSICRO_VAU, PSICRO_TBU, tr_vau_tbu, NUCLEO_P)
+
+#endif
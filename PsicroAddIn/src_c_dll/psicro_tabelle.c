@@ -0,0 +1,319 @@
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicro_tabelle.h"
+#include "psicro_core.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#define MAGIC_TAB    "PSICROTB"
+#define N_COSTANTI   9
+
+// Intestazione del file; le tabelle seguono a partire da OFFSET_DATI
+typedef struct {
+    char magic[8];
+    uint32_t versione, versione_modello;
+    double costanti[N_COSTANTI];    // Vedi costanti_modello
+    double patm;
+    double t_min, passo_t;
+    int64_t n_t;
+    double tbu_t_min, tbu_passo_t, tbu_passo_x;
+    int64_t tbu_n_t, tbu_n_x;
+    double psat_ghiaccio[2];        // Valore e derivata lato ghiaccio nel nodo di T_TRIPLO
+    double xsat_ghiaccio[2];
+    uint64_t byte;                  // Dimensione totale del file
+} intestazione;
+
+#define OFFSET_DATI  ((sizeof(intestazione) + 63) & ~(size_t)63)
+
+struct psicro_tabelle {
+    const intestazione* h;
+    const double* psat;             // [n_t]
+    const double* dpsat;            // [n_t]
+    const double* xsat;             // [n_t]
+    const double* dxsat;            // [n_t]
+    const double* tbu;              // [tbu_n_t][tbu_n_x]
+    long long k_triplo;             // Nodo di T_TRIPLO
+    void* base;
+    size_t dim;
+    int mappata;
+#ifdef _WIN32
+    HANDLE file, mappa;
+#endif
+};
+
+static void costanti_modello(double c[N_COSTANTI]) {
+    const double v[N_COSTANTI] = { RAV, RA, CPAS, CPV, CPW, CPICE, LAMBDA, LAMBDA_ICE, T_TRIPLO };
+    memcpy(c, v, sizeof(v));
+}
+
+// Geometria compilata: un file con un'altra geometria si rifiuta e si ricostruisce
+static void geometria(intestazione* h) {
+    h->t_min = PSICRO_TAB_T_MIN;
+    h->passo_t = PSICRO_TAB_PASSO_T;
+    h->n_t = (int64_t)floor((PSICRO_TAB_T_MAX - PSICRO_TAB_T_MIN) / PSICRO_TAB_PASSO_T + 0.5) + 1;
+    h->tbu_t_min = PSICRO_TAB_TBU_T_MIN;
+    h->tbu_passo_t = PSICRO_TAB_TBU_PASSO_T;
+    h->tbu_passo_x = PSICRO_TAB_TBU_PASSO_X;
+    h->tbu_n_t = (int64_t)floor((PSICRO_TAB_TBU_T_MAX - PSICRO_TAB_TBU_T_MIN) / PSICRO_TAB_TBU_PASSO_T + 0.5) + 1;
+    h->tbu_n_x = (int64_t)floor(PSICRO_TAB_TBU_X_MAX / PSICRO_TAB_TBU_PASSO_X + 0.5) + 1;
+}
+
+static size_t byte_totali(const intestazione* h) {
+    return OFFSET_DATI + (size_t)(4 * h->n_t + h->tbu_n_t * h->tbu_n_x) * sizeof(double);
+}
+
+// Puntatori alle tabelle dentro base (già validata)
+static void collega(psicro_tabelle* tab) {
+    const intestazione* h = (const intestazione*)tab->base;
+    const double* d = (const double*)((const char*)tab->base + OFFSET_DATI);
+    tab->h = h;
+    tab->psat = d;
+    tab->dpsat = d + h->n_t;
+    tab->xsat = d + 2 * h->n_t;
+    tab->dxsat = d + 3 * h->n_t;
+    tab->tbu = d + 4 * h->n_t;
+    tab->k_triplo = (long long)floor((T_TRIPLO - h->t_min) / h->passo_t + 0.5);
+}
+
+PSICRO_EXPORT psicro_tabelle* PSICRO_CALL psicro_tabelle_crea(double patm) {
+    if (!(patm > 0.0)) return NULL;
+    intestazione h0;
+    memset(&h0, 0, sizeof(h0));
+    memcpy(h0.magic, MAGIC_TAB, 8);
+    h0.versione = PSICRO_TAB_VERSIONE;
+    h0.versione_modello = PSICRO_TAB_VERSIONE_MODELLO;
+    costanti_modello(h0.costanti);
+    h0.patm = patm;
+    geometria(&h0);
+    h0.byte = byte_totali(&h0);
+    // Lato ghiaccio in T_TRIPLO (il nodo tiene il lato acqua)
+    const double t_g = nextafter(T_TRIPLO, -1.0);
+    const double ps_g = core_Psat(t_g);
+    h0.psat_ghiaccio[0] = ps_g;
+    h0.psat_ghiaccio[1] = core_dPsat_dt(t_g);
+    h0.xsat_ghiaccio[0] = RAV * ps_g / (patm - ps_g);
+    h0.xsat_ghiaccio[1] = RAV * patm * h0.psat_ghiaccio[1] / ((patm - ps_g) * (patm - ps_g));
+
+    psicro_tabelle* tab = (psicro_tabelle*)calloc(1, sizeof(psicro_tabelle));
+    if (tab == NULL) return NULL;
+    tab->dim = (size_t)h0.byte;
+    tab->base = malloc(tab->dim);
+    if (tab->base == NULL) {
+        free(tab);
+        return NULL;
+    }
+    memset(tab->base, 0, OFFSET_DATI);
+    memcpy(tab->base, &h0, sizeof(h0));
+    collega(tab);
+    double* psat = (double*)tab->psat;
+    double* dpsat = (double*)tab->dpsat;
+    double* xsat = (double*)tab->xsat;
+    double* dxsat = (double*)tab->dxsat;
+    double* tbu = (double*)tab->tbu;
+
+    for (long long i = 0; i < h0.n_t; i++) {
+        // Il nodo di T_TRIPLO esattamente lì (i * passo lo lascerebbe lato ghiaccio)
+        const double t = (i == tab->k_triplo) ? T_TRIPLO : h0.t_min + (double)i * h0.passo_t;
+        const double ps = core_Psat(t);
+        const double dps = core_dPsat_dt(t);
+        psat[i] = ps;
+        dpsat[i] = dps;
+        // Oltre l'ebollizione alla pressione data il titolo di saturazione non esiste
+        xsat[i] = (ps < patm) ? RAV * ps / (patm - ps) : NAN;
+        dxsat[i] = (ps < patm) ? RAV * patm * dps / ((patm - ps) * (patm - ps)) : NAN;
+    }
+    // tbu: una bisezione per nodo, righe in parallelo. Sempre con il profilo
+    // di riferimento: il file è condiviso da processi e thread con profili
+    // diversi e l'intestazione non registra le tolleranze
+    const long long n_x = h0.tbu_n_x;
+#pragma omp parallel
+    {
+        const psicro_tolleranze* salva = psicro_prec_thread;
+        psicro_prec_thread = &psicro_profili[PSICRO_PREC_RIFERIMENTO];
+#pragma omp for schedule(dynamic)
+        for (long long i = 0; i < h0.tbu_n_t; i++) {
+            const double t = h0.tbu_t_min + (double)i * h0.tbu_passo_t;
+            for (long long j = 0; j < n_x; j++) {
+                const double x = (double)j * h0.tbu_passo_x;
+                const double v = core_tbu_x_h(x, core_h_t_x(t, x), patm);
+                tbu[i * n_x + j] = (v > -999.0 && isfinite(v)) ? v : NAN;
+            }
+        }
+        psicro_prec_thread = salva;
+    }
+    return tab;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_tabelle_salva(const psicro_tabelle* tab, const char* file) {
+    if (!tab || !file) return PSICRO_ERR_ARG;
+    // Nome temporaneo per processo, poi rinomina: i lettori vedono il file vecchio o quello completo
+    char tmp[1024];
+#ifdef _WIN32
+    snprintf(tmp, sizeof(tmp), "%s.tmp%lu", file, (unsigned long)GetCurrentProcessId());
+#else
+    snprintf(tmp, sizeof(tmp), "%s.tmp%ld", file, (long)getpid());
+#endif
+    FILE* f = fopen(tmp, "wb");
+    if (f == NULL) return PSICRO_ERR_DATI;
+    size_t scritti = fwrite(tab->base, 1, tab->dim, f);
+    if (fclose(f) != 0 || scritti != tab->dim) {
+        remove(tmp);
+        return PSICRO_ERR_DATI;
+    }
+#ifdef _WIN32
+    if (!MoveFileExA(tmp, file, MOVEFILE_REPLACE_EXISTING)) {
+#else
+    if (rename(tmp, file) != 0) {
+#endif
+        remove(tmp);
+        return PSICRO_ERR_DATI;
+    }
+    return PSICRO_OK;
+}
+
+static int intestazione_valida(const void* base, size_t dim, double patm) {
+    if (dim < OFFSET_DATI) return 0;
+    const intestazione* h = (const intestazione*)base;
+    intestazione g;
+    double c[N_COSTANTI];
+    costanti_modello(c);
+    geometria(&g);
+    return memcmp(h->magic, MAGIC_TAB, 8) == 0
+        && h->versione == PSICRO_TAB_VERSIONE
+        && h->versione_modello == PSICRO_TAB_VERSIONE_MODELLO
+        && memcmp(h->costanti, c, sizeof(c)) == 0
+        && h->patm == patm
+        && h->t_min == g.t_min && h->passo_t == g.passo_t && h->n_t == g.n_t
+        && h->tbu_t_min == g.tbu_t_min && h->tbu_passo_t == g.tbu_passo_t && h->tbu_passo_x == g.tbu_passo_x
+        && h->tbu_n_t == g.tbu_n_t && h->tbu_n_x == g.tbu_n_x
+        && h->byte == byte_totali(&g) && h->byte == (uint64_t)dim;
+}
+
+PSICRO_EXPORT psicro_tabelle* PSICRO_CALL psicro_tabelle_apri(const char* file, double patm) {
+    if (!file) return NULL;
+    psicro_tabelle* tab = (psicro_tabelle*)calloc(1, sizeof(psicro_tabelle));
+    if (tab == NULL) return NULL;
+    tab->mappata = 1;   // psicro_tabelle_libera chiude quanto aperto finora
+#ifdef _WIN32
+    tab->file = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER dim;
+    if (tab->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(tab->file, &dim) || dim.QuadPart < (LONGLONG)OFFSET_DATI) goto errore;
+    tab->dim = (size_t)dim.QuadPart;
+    tab->mappa = CreateFileMappingA(tab->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (tab->mappa == NULL) goto errore;
+    tab->base = MapViewOfFile(tab->mappa, FILE_MAP_READ, 0, 0, 0);
+    if (tab->base == NULL) goto errore;
+#else
+    int fd = open(file, O_RDONLY);
+    if (fd < 0) goto errore;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)OFFSET_DATI) {
+        close(fd);
+        goto errore;
+    }
+    tab->dim = (size_t)st.st_size;
+    // MAP_SHARED in sola lettura: tutti i processi usano le stesse pagine della cache del SO
+    void* p = mmap(NULL, tab->dim, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) goto errore;
+    tab->base = p;
+#endif
+    if (!intestazione_valida(tab->base, tab->dim, patm)) goto errore;
+    collega(tab);
+    return tab;
+errore:
+    psicro_tabelle_libera(tab);
+    return NULL;
+}
+
+PSICRO_EXPORT psicro_tabelle* PSICRO_CALL psicro_tabelle_carica(const char* file, double patm) {
+    psicro_tabelle* tab = psicro_tabelle_apri(file, patm);
+    if (tab) return tab;
+    tab = psicro_tabelle_crea(patm);
+    if (tab == NULL || file == NULL || psicro_tabelle_salva(tab, file) != PSICRO_OK) return tab;
+    // Riaperto dal file: le pagine sono quelle condivise con gli altri processi
+    psicro_tabelle* mappate = psicro_tabelle_apri(file, patm);
+    if (mappate == NULL) return tab;
+    psicro_tabelle_libera(tab);
+    return mappate;
+}
+
+PSICRO_EXPORT void PSICRO_CALL psicro_tabelle_libera(psicro_tabelle* tab) {
+    if (!tab) return;
+    if (!tab->mappata) free(tab->base);
+#ifdef _WIN32
+    else {
+        if (tab->base) UnmapViewOfFile(tab->base);
+        if (tab->mappa) CloseHandle(tab->mappa);
+        if (tab->file && tab->file != INVALID_HANDLE_VALUE) CloseHandle(tab->file);
+    }
+#else
+    else if (tab->base) munmap(tab->base, tab->dim);
+#endif
+    free(tab);
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_tabelle_mappate(const psicro_tabelle* tab) {
+    return tab ? tab->mappata : 0;
+}
+
+// --- LETTURE ---
+// Hermite cubica nella cella di t; nella cella che termina in T_TRIPLO il nodo
+// destro usa valore e derivata lato ghiaccio (g)
+static double hermite(const psicro_tabelle* tab, const double* y, const double* d, const double g[2], double t) {
+    const intestazione* h = tab->h;
+    long long i = (long long)((t - h->t_min) / h->passo_t);
+    if (i > h->n_t - 2) i = h->n_t - 2;
+    const double u = (t - h->t_min) / h->passo_t - (double)i;
+    const int ghiaccio = (i + 1 == tab->k_triplo && t < T_TRIPLO);
+    const double y1 = ghiaccio ? g[0] : y[i + 1];
+    const double d1 = ghiaccio ? g[1] : d[i + 1];
+    const double v = 1.0 - u;
+    return y[i] * (1.0 + 2.0 * u) * v * v + h->passo_t * d[i] * u * v * v
+        + y1 * u * u * (3.0 - 2.0 * u) - h->passo_t * d1 * u * u * v;
+}
+
+static int in_campo_t(const psicro_tabelle* tab, double t) {
+    const intestazione* h = tab->h;
+    return t >= h->t_min && t <= h->t_min + (double)(h->n_t - 1) * h->passo_t;
+}
+
+PSICRO_EXPORT double PSICRO_CALL psicro_tab_psat(const psicro_tabelle* tab, double t) {
+    if (!tab) return NAN;
+    if (!in_campo_t(tab, t)) return core_Psat(t);
+    return hermite(tab, tab->psat, tab->dpsat, tab->h->psat_ghiaccio, t);
+}
+
+PSICRO_EXPORT double PSICRO_CALL psicro_tab_xsat(const psicro_tabelle* tab, double t) {
+    if (!tab) return NAN;
+    if (in_campo_t(tab, t)) {
+        double v = hermite(tab, tab->xsat, tab->dxsat, tab->h->xsat_ghiaccio, t);
+        if (isfinite(v)) return v;
+    }
+    return core_xsat_t(t, tab->h->patm);
+}
+
+PSICRO_EXPORT double PSICRO_CALL psicro_tab_tbu(const psicro_tabelle* tab, double t, double x) {
+    if (!tab) return NAN;
+    const intestazione* h = tab->h;
+    const double ut = (t - h->tbu_t_min) / h->tbu_passo_t;
+    const double ux = x / h->tbu_passo_x;
+    if (ut >= 0.0 && ut <= (double)(h->tbu_n_t - 1) && ux >= 0.0 && ux <= (double)(h->tbu_n_x - 1)) {
+        long long i = (long long)ut, j = (long long)ux;
+        if (i > h->tbu_n_t - 2) i = h->tbu_n_t - 2;
+        if (j > h->tbu_n_x - 2) j = h->tbu_n_x - 2;
+        const double a = ut - (double)i, b = ux - (double)j;
+        const double* r0 = tab->tbu + i * h->tbu_n_x + j;
+        const double* r1 = r0 + h->tbu_n_x;
+        const double v = (1.0 - a) * ((1.0 - b) * r0[0] + b * r0[1]) + a * ((1.0 - b) * r1[0] + b * r1[1]);
+        if (isfinite(v)) return v;
+    }
+    return core_tbu_x_h(x, core_h_t_x(t, x), h->patm);
+}
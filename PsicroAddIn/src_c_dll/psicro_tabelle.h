@@ -0,0 +1,54 @@
+#ifndef PSICRO_TABELLE_H
+#define PSICRO_TABELLE_H
+
+#include "psicrometria.h"
+
+// --- TABELLE PRECALCOLATE SU FILE CONDIVISO ---
+// Tabelle di interpolazione a una pressione data:
+//   Psat(t), xsat(t)   Hermite cubica su valori e derivate esatte, passo PSICRO_TAB_PASSO_T
+//   tbu(t, x)          bilineare su griglia PSICRO_TAB_TBU_PASSO_T x PSICRO_TAB_TBU_PASSO_X
+// I nodi si calcolano sempre con il profilo di precisione di riferimento,
+// qualunque sia quello del chiamante.
+// Costruirle costa soprattutto per tbu (una bisezione per nodo). Le si
+// serializza una volta in un file binario versionato; i processi successivi
+// lo mappano in sola lettura (mmap / MapViewOfFile) e condividono le pagine
+// della cache del SO: un processo nuovo è subito a regime senza ricalcolare.
+//
+// L'intestazione porta versione del formato, versione dei modelli, costanti
+// fondamentali, pressione e geometria delle griglie; un file che non combacia
+// in tutto si rifiuta. Il file è nel formato nativo dell'host (endianness,
+// double IEEE) e si scrive su un nome temporaneo rinominato alla fine, così
+// un lettore non vede mai un file a metà.
+//
+// Fuori dalle griglie (o in nodi senza valore) le letture ricadono sul
+// calcolo esatto del nucleo alla pressione delle tabelle.
+#define PSICRO_TAB_VERSIONE          1        // Formato del file
+#define PSICRO_TAB_VERSIONE_MODELLO  1        // Da incrementare se cambiano le formule del nucleo
+#define PSICRO_TAB_T_MIN           -49.99     // Nodo su T_TRIPLO: la derivata di Psat salta lì
+#define PSICRO_TAB_T_MAX            89.99
+#define PSICRO_TAB_PASSO_T           0.05
+#define PSICRO_TAB_TBU_T_MIN       -30.0
+#define PSICRO_TAB_TBU_T_MAX        60.0
+#define PSICRO_TAB_TBU_PASSO_T       0.1
+#define PSICRO_TAB_TBU_X_MAX         0.04
+#define PSICRO_TAB_TBU_PASSO_X       0.0001
+
+typedef struct psicro_tabelle psicro_tabelle;
+
+// Costruisce le tabelle in memoria alla pressione patm [kPa]
+PSICRO_EXPORT psicro_tabelle* PSICRO_CALL psicro_tabelle_crea(double patm);
+PSICRO_EXPORT int PSICRO_CALL psicro_tabelle_salva(const psicro_tabelle* tab, const char* file);
+// Mappa il file in sola lettura; NULL se manca o non combacia (versioni, costanti, patm)
+PSICRO_EXPORT psicro_tabelle* PSICRO_CALL psicro_tabelle_apri(const char* file, double patm);
+// Apre il file; se non è valido costruisce, salva e riapre (in memoria se il salvataggio fallisce)
+PSICRO_EXPORT psicro_tabelle* PSICRO_CALL psicro_tabelle_carica(const char* file, double patm);
+PSICRO_EXPORT void PSICRO_CALL psicro_tabelle_libera(psicro_tabelle* tab);
+// 1 se le tabelle sono mappate da file, 0 se in memoria
+PSICRO_EXPORT int PSICRO_CALL psicro_tabelle_mappate(const psicro_tabelle* tab);
+
+// Letture (pressione delle tabelle)
+PSICRO_EXPORT double PSICRO_CALL psicro_tab_psat(const psicro_tabelle* tab, double t);
+PSICRO_EXPORT double PSICRO_CALL psicro_tab_xsat(const psicro_tabelle* tab, double t);
+PSICRO_EXPORT double PSICRO_CALL psicro_tab_tbu(const psicro_tabelle* tab, double t, double x);
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef PSICRO_THREAD_H
+#define PSICRO_THREAD_H
+
+// Primitive di sincronizzazione minime: Win32 (SRWLOCK, CONDITION_VARIABLE)
+// o pthread. Solo per uso interno ai moduli della DLL.
+
+#include "psicrometria.h"
+
+#ifdef _WIN32
+	typedef HANDLE psicro_thread_t;
+	typedef SRWLOCK psicro_mutex;
+	typedef CONDITION_VARIABLE psicro_cond;
+	#define PSICRO_MUTEX_INIT   SRWLOCK_INIT
+	#define PSICRO_TLS          __declspec(thread)
+	typedef DWORD psicro_thread_ret;
+	#define PSICRO_THREAD_FN    WINAPI
+#else
+	#include <pthread.h>
+	#include <time.h>
+	#include <unistd.h>
+	typedef pthread_t psicro_thread_t;
+	typedef pthread_mutex_t psicro_mutex;
+	typedef pthread_cond_t psicro_cond;
+	#define PSICRO_MUTEX_INIT   PTHREAD_MUTEX_INITIALIZER
+	#define PSICRO_TLS          __thread
+	typedef void* psicro_thread_ret;
+	#define PSICRO_THREAD_FN
+#endif
+
+typedef psicro_thread_ret (PSICRO_THREAD_FN *psicro_thread_main)(void* arg);
+
+PSICRO_INLINE void psicro_mutex_init(psicro_mutex* m) {
+#ifdef _WIN32
+    InitializeSRWLock(m);
+#else
+    pthread_mutex_init(m, NULL);
+#endif
+}
+PSICRO_INLINE void psicro_mutex_destroy(psicro_mutex* m) {
+#ifdef _WIN32
+    (void)m;
+#else
+    pthread_mutex_destroy(m);
+#endif
+}
+PSICRO_INLINE void psicro_mutex_lock(psicro_mutex* m) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(m);
+#else
+    pthread_mutex_lock(m);
+#endif
+}
+PSICRO_INLINE void psicro_mutex_unlock(psicro_mutex* m) {
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(m);
+#else
+    pthread_mutex_unlock(m);
+#endif
+}
+PSICRO_INLINE void psicro_cond_init(psicro_cond* c) {
+#ifdef _WIN32
+    InitializeConditionVariable(c);
+#else
+    pthread_cond_init(c, NULL);
+#endif
+}
+PSICRO_INLINE void psicro_cond_destroy(psicro_cond* c) {
+#ifdef _WIN32
+    (void)c;
+#else
+    pthread_cond_destroy(c);
+#endif
+}
+PSICRO_INLINE void psicro_cond_broadcast(psicro_cond* c) {
+#ifdef _WIN32
+    WakeAllConditionVariable(c);
+#else
+    pthread_cond_broadcast(c);
+#endif
+}
+// Attende su c per al massimo timeout_ms (< 0: senza limite); m già acquisito
+PSICRO_INLINE void psicro_cond_wait(psicro_cond* c, psicro_mutex* m, int timeout_ms) {
+#ifdef _WIN32
+    SleepConditionVariableSRW(c, m, (timeout_ms < 0) ? INFINITE : (DWORD)timeout_ms, 0);
+#else
+    if (timeout_ms < 0) {
+        pthread_cond_wait(c, m);
+        return;
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout_ms / 1000;
+    ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait(c, m, &ts);
+#endif
+}
+// 1 se il thread è partito
+PSICRO_INLINE int psicro_thread_create(psicro_thread_t* th, psicro_thread_main fn, void* arg) {
+#ifdef _WIN32
+    *th = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    return (*th != NULL);
+#else
+    return (pthread_create(th, NULL, fn, arg) == 0);
+#endif
+}
+PSICRO_INLINE void psicro_thread_join(psicro_thread_t th) {
+#ifdef _WIN32
+    WaitForSingleObject(th, INFINITE);
+    CloseHandle(th);
+#else
+    pthread_join(th, NULL);
+#endif
+}
+PSICRO_INLINE int psicro_numero_cpu(void) {
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int)si.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+#endif
+}
+// Lettura e scrittura atomiche a 64 bit senza ordinamento: contatori con un
+// solo scrittore letti da altri thread
+PSICRO_INLINE unsigned long long psicro_atomica_leggi(const unsigned long long* p) {
+#if defined(_WIN64)
+    return *(const volatile unsigned long long*)p;
+#elif defined(_WIN32)
+    return (unsigned long long)InterlockedCompareExchange64((volatile LONG64*)p, 0, 0);
+#else
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+#endif
+}
+PSICRO_INLINE void psicro_atomica_scrivi(unsigned long long* p, unsigned long long v) {
+#if defined(_WIN64)
+    *(volatile unsigned long long*)p = v;
+#elif defined(_WIN32)
+    InterlockedExchange64((volatile LONG64*)p, (LONG64)v);
+#else
+    __atomic_store_n(p, v, __ATOMIC_RELAXED);
+#endif
+}
+// Tempo monotono in nanosecondi
+PSICRO_INLINE unsigned long long psicro_ora_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER c;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&c);
+    return (unsigned long long)((double)c.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+#endif
@@ -0,0 +1,273 @@
+#include "psicro_trace.h"
+#include "psicro_thread.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef PSICRO_TRACE
+
+// Classi: valori < 16 ns esatti, poi 16 sottoclassi per ogni ottava
+#define SUB_BIT     4
+#define SUB_N       (1 << SUB_BIT)
+#define N_CLASSI    ((64 - SUB_BIT + 1) * SUB_N)
+
+typedef struct {
+    unsigned long long chiamate, somma, min, max;
+    unsigned long long* classi;      // N_CLASSI contatori, allocati alla prima chiamata
+} traccia_funz;
+
+// Ogni blocco è scritto solo dal suo thread (contatori con scritture atomiche
+// rilassate). psicro_trace_reset non tocca i blocchi: incrementa l'epoca e
+// ciascun thread azzera il proprio blocco alla registrazione successiva; la
+// lettura ignora i blocchi di un'epoca precedente. Alla fine del thread il
+// blocco si fonde in 'terminati' e si libera.
+typedef struct blocco_thread {
+    traccia_funz f[PSICRO_TRACE_MAX_FUNZ];
+    unsigned long long epoca;                   // Scritta sotto mtx_registro
+    struct blocco_thread *prec, *succ;
+} blocco_thread;
+
+static psicro_mutex mtx_registro = PSICRO_MUTEX_INIT;
+static char nomi[PSICRO_TRACE_MAX_FUNZ][40];
+static int n_funz = 0;
+static blocco_thread* blocchi = NULL;           // Thread vivi
+static blocco_thread terminati;                 // Somma dei thread terminati (solo sotto mtx_registro)
+static unsigned long long epoca = 0;            // Scritta sotto mtx_registro
+static PSICRO_TLS blocco_thread* locale = NULL;
+
+static int msb(unsigned long long v) {
+    int e = 0;
+    if (v >> 32) { v >>= 32; e += 32; }
+    if (v >> 16) { v >>= 16; e += 16; }
+    if (v >> 8) { v >>= 8; e += 8; }
+    if (v >> 4) { v >>= 4; e += 4; }
+    if (v >> 2) { v >>= 2; e += 2; }
+    if (v >> 1) { e += 1; }
+    return e;
+}
+static int classe(unsigned long long v) {
+    if (v < SUB_N) return (int)v;
+    int e = msb(v);
+    return (e - SUB_BIT + 1) * SUB_N + (int)((v >> (e - SUB_BIT)) & (SUB_N - 1));
+}
+// Limite superiore (escluso) della classe in ns
+static unsigned long long limite_classe(int k) {
+    if (k < SUB_N) return (unsigned long long)k + 1;
+    int e = k / SUB_N + SUB_BIT - 1;
+    unsigned long long m = (unsigned long long)(k % SUB_N);
+    return (SUB_N + m + 1) << (e - SUB_BIT);
+}
+
+int psicro_trace_id(const char* nome) {
+    psicro_mutex_lock(&mtx_registro);
+    int id;
+    for (id = 0; id < n_funz; id++) {
+        if (strcmp(nomi[id], nome) == 0) break;
+    }
+    if (id == n_funz && n_funz < PSICRO_TRACE_MAX_FUNZ) {
+        strncpy(nomi[id], nome, sizeof(nomi[id]) - 1);
+        n_funz++;
+    }
+    psicro_mutex_unlock(&mtx_registro);
+    return (id < PSICRO_TRACE_MAX_FUNZ) ? id : PSICRO_TRACE_MAX_FUNZ - 1;
+}
+
+int psicro_trace_id_cache(unsigned long long* cache, const char* nome) {
+    unsigned long long c = psicro_atomica_leggi(cache);
+    if (c == 0) {
+        c = (unsigned long long)psicro_trace_id(nome) + 1;
+        psicro_atomica_scrivi(cache, c);
+    }
+    return (int)(c - 1);
+}
+
+unsigned long long psicro_trace_ns(void) { return psicro_ora_ns(); }
+
+// --- FINE DEL THREAD ---
+// Distruttore TLS (pthread_key / FLS) registrato con il primo blocco
+static void fine_thread(void* p);
+#ifdef _WIN32
+static DWORD chiave_fine = FLS_OUT_OF_INDEXES;
+static VOID WINAPI fine_thread_fls(PVOID p) { if (p) fine_thread(p); }
+static void chiave_imposta(blocco_thread* b) {
+    if (chiave_fine == FLS_OUT_OF_INDEXES) chiave_fine = FlsAlloc(fine_thread_fls);
+    if (chiave_fine != FLS_OUT_OF_INDEXES) FlsSetValue(chiave_fine, b);
+}
+#else
+static pthread_key_t chiave_fine;
+static int chiave_creata = 0;
+static void chiave_imposta(blocco_thread* b) {
+    if (!chiave_creata) chiave_creata = (pthread_key_create(&chiave_fine, fine_thread) == 0);
+    if (chiave_creata) pthread_setspecific(chiave_fine, b);
+}
+#endif
+
+// Somma src in dst; sotto mtx_registro
+static int accumula(traccia_funz* dst, const traccia_funz* src) {
+    if (src->classi == NULL || src->chiamate == 0) return 1;
+    if (dst->classi == NULL) {
+        dst->classi = (unsigned long long*)calloc(N_CLASSI, sizeof(unsigned long long));
+        if (dst->classi == NULL) return 0;
+        dst->min = ~0ULL;
+    }
+    dst->chiamate += src->chiamate;
+    dst->somma += src->somma;
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+    for (int k = 0; k < N_CLASSI; k++) dst->classi[k] += src->classi[k];
+    return 1;
+}
+
+static void fine_thread(void* p) {
+    blocco_thread* b = (blocco_thread*)p;
+    psicro_mutex_lock(&mtx_registro);
+    for (int id = 0; id < PSICRO_TRACE_MAX_FUNZ; id++) {
+        if (b->epoca == epoca) accumula(&terminati.f[id], &b->f[id]);
+        free(b->f[id].classi);
+    }
+    if (b->prec) b->prec->succ = b->succ;
+    else blocchi = b->succ;
+    if (b->succ) b->succ->prec = b->prec;
+    psicro_mutex_unlock(&mtx_registro);
+    if (locale == b) locale = NULL;
+    free(b);
+}
+
+// Azzera il blocco del thread chiamante; sotto mtx_registro
+static void azzera(blocco_thread* b) {
+    for (int id = 0; id < PSICRO_TRACE_MAX_FUNZ; id++) {
+        traccia_funz* f = &b->f[id];
+        if (f->classi == NULL) continue;
+        f->chiamate = f->somma = f->max = 0;
+        f->min = ~0ULL;
+        memset(f->classi, 0, N_CLASSI * sizeof(unsigned long long));
+    }
+    b->epoca = epoca;
+}
+
+void psicro_trace_registra(int id, unsigned long long durata_ns) {
+    blocco_thread* b = locale;
+    if (b == NULL) {
+        b = (blocco_thread*)calloc(1, sizeof(blocco_thread));
+        if (b == NULL) return;
+        psicro_mutex_lock(&mtx_registro);
+        b->epoca = epoca;
+        b->succ = blocchi;
+        if (blocchi) blocchi->prec = b;
+        blocchi = b;
+        chiave_imposta(b);
+        psicro_mutex_unlock(&mtx_registro);
+        locale = b;
+    }
+    if (b->epoca != psicro_atomica_leggi(&epoca)) {
+        psicro_mutex_lock(&mtx_registro);
+        azzera(b);
+        psicro_mutex_unlock(&mtx_registro);
+    }
+    traccia_funz* f = &b->f[id];
+    if (f->classi == NULL) {
+        unsigned long long* c = (unsigned long long*)calloc(N_CLASSI, sizeof(unsigned long long));
+        if (c == NULL) return;
+        psicro_mutex_lock(&mtx_registro);
+        f->min = ~0ULL;
+        f->classi = c;
+        psicro_mutex_unlock(&mtx_registro);
+    }
+    psicro_atomica_scrivi(&f->chiamate, f->chiamate + 1);
+    psicro_atomica_scrivi(&f->somma, f->somma + durata_ns);
+    if (durata_ns < f->min) psicro_atomica_scrivi(&f->min, durata_ns);
+    if (durata_ns > f->max) psicro_atomica_scrivi(&f->max, durata_ns);
+    unsigned long long* c = &f->classi[classe(durata_ns)];
+    psicro_atomica_scrivi(c, *c + 1);
+}
+
+// Percentile dall'istogramma fuso (limite superiore della classe)
+static unsigned long long percentile(const unsigned long long* classi, unsigned long long tot, double q) {
+    unsigned long long soglia = (unsigned long long)(q * (double)tot);
+    unsigned long long cum = 0;
+    for (int k = 0; k < N_CLASSI; k++) {
+        cum += classi[k];
+        if (cum > soglia) return limite_classe(k);
+    }
+    return limite_classe(N_CLASSI - 1);
+}
+
+// Accodamento con troncamento: 'pos' conta comunque la lunghezza completa
+static void scrivi(char* buf, int len, int* pos, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int resto = (*pos < len) ? len - *pos : 0;
+    int n = vsnprintf(resto > 0 ? buf + *pos : NULL, (size_t)resto, fmt, ap);
+    va_end(ap);
+    if (n > 0) *pos += n;
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_trace_json(char* buf, int len) {
+    if (buf == NULL) len = 0;
+    int pos = 0;
+    unsigned long long* fuse = (unsigned long long*)malloc(N_CLASSI * sizeof(unsigned long long));
+    if (fuse == NULL) return -1;
+    scrivi(buf, len, &pos, "{\"abilitato\":true,\"funzioni\":[");
+    psicro_mutex_lock(&mtx_registro);
+    int primo = 1;
+    for (int id = 0; id < n_funz; id++) {
+        unsigned long long chiamate = 0, somma = 0, mn = ~0ULL, mx = 0;
+        memset(fuse, 0, N_CLASSI * sizeof(unsigned long long));
+        for (blocco_thread* b = &terminati; b; b = (b == &terminati) ? blocchi : b->succ) {
+            if (b != &terminati && b->epoca != epoca) continue;
+            traccia_funz* f = &b->f[id];
+            if (f->classi == NULL || psicro_atomica_leggi(&f->chiamate) == 0) continue;
+            chiamate += psicro_atomica_leggi(&f->chiamate);
+            somma += psicro_atomica_leggi(&f->somma);
+            const unsigned long long f_min = psicro_atomica_leggi(&f->min), f_max = psicro_atomica_leggi(&f->max);
+            if (f_min < mn) mn = f_min;
+            if (f_max > mx) mx = f_max;
+            for (int k = 0; k < N_CLASSI; k++) fuse[k] += psicro_atomica_leggi(&f->classi[k]);
+        }
+        if (chiamate == 0) continue;
+        unsigned long long tot = 0;
+        for (int k = 0; k < N_CLASSI; k++) tot += fuse[k];
+        scrivi(buf, len, &pos, "%s{\"nome\":\"%s\",\"chiamate\":%llu,\"min_ns\":%llu,\"max_ns\":%llu,\"media_ns\":%.1f,"
+            "\"p50_ns\":%llu,\"p90_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,\"classi\":[",
+            primo ? "" : ",", nomi[id], chiamate, mn, mx, (double)somma / (double)chiamate,
+            percentile(fuse, tot, 0.5), percentile(fuse, tot, 0.9), percentile(fuse, tot, 0.99), percentile(fuse, tot, 0.999));
+        int prima_classe = 1;
+        for (int k = 0; k < N_CLASSI; k++) {
+            if (fuse[k] == 0) continue;
+            scrivi(buf, len, &pos, "%s[%llu,%llu]", prima_classe ? "" : ",", limite_classe(k), fuse[k]);
+            prima_classe = 0;
+        }
+        scrivi(buf, len, &pos, "]}");
+        primo = 0;
+    }
+    psicro_mutex_unlock(&mtx_registro);
+    scrivi(buf, len, &pos, "]}");
+    free(fuse);
+    return pos + 1;
+}
+
+PSICRO_EXPORT void PSICRO_CALL psicro_trace_reset(void) {
+    psicro_mutex_lock(&mtx_registro);
+    psicro_atomica_scrivi(&epoca, epoca + 1);
+    for (int id = 0; id < PSICRO_TRACE_MAX_FUNZ; id++) {
+        free(terminati.f[id].classi);
+        memset(&terminati.f[id], 0, sizeof(traccia_funz));
+    }
+    psicro_mutex_unlock(&mtx_registro);
+}
+
+#else
+
+PSICRO_EXPORT int PSICRO_CALL psicro_trace_json(char* buf, int len) {
+    const char* vuoto = "{\"abilitato\":false,\"funzioni\":[]}";
+    int n = (int)strlen(vuoto);
+    if (buf && len > 0) {
+        strncpy(buf, vuoto, (size_t)len - 1);
+        buf[len - 1] = '\0';
+    }
+    return n + 1;
+}
+PSICRO_EXPORT void PSICRO_CALL psicro_trace_reset(void) {}
+
+#endif
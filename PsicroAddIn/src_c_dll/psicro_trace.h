@@ -0,0 +1,42 @@
+#ifndef PSICRO_TRACE_H
+#define PSICRO_TRACE_H
+
+#include "psicrometria.h"
+
+// --- TRACCIAMENTO DELLE LATENZE (opzionale, compilare con PSICRO_TRACE) ---
+// Ogni punto di ingresso avvolto con PSICRO_TRACCIA registra la durata della
+// chiamata in un istogramma log-lineare (stile HDR: 16 sottoclassi per ottava,
+// errore relativo < 6,25%) del thread chiamante, con scritture atomiche
+// rilassate e senza lock.
+// La lettura (psicro_trace_json) fonde gli istogrammi di tutti i thread.
+// Senza PSICRO_TRACE la macro si riduce a 'return espr;': nessun costo.
+
+#define PSICRO_TRACE_MAX_FUNZ   256
+
+#ifdef PSICRO_TRACE
+	int psicro_trace_id(const char* nome);
+	// Id con cache per punto di chiamata (*cache = id + 1, 0 se da cercare)
+	int psicro_trace_id_cache(unsigned long long* cache, const char* nome);
+	unsigned long long psicro_trace_ns(void);
+	void psicro_trace_registra(int id, unsigned long long durata_ns);
+
+	#define PSICRO_TRACCIA(nome, espr) do { \
+		static unsigned long long id_traccia_ = 0; \
+		int n_traccia_ = psicro_trace_id_cache(&id_traccia_, #nome); \
+		unsigned long long t0_traccia_ = psicro_trace_ns(); \
+		double r_traccia_ = (espr); \
+		psicro_trace_registra(n_traccia_, psicro_trace_ns() - t0_traccia_); \
+		return r_traccia_; \
+	} while (0)
+#else
+	#define PSICRO_TRACCIA(nome, espr) return (espr)
+#endif
+
+// JSON con chiamate, min/max/media e percentili per funzione. Scrive al più
+// len byte (terminatore incluso) e ritorna la lunghezza completa richiesta.
+// Senza PSICRO_TRACE produce {"abilitato":false,"funzioni":[]}.
+PSICRO_EXPORT int PSICRO_CALL psicro_trace_json(char* buf, int len);
+// Azzera i contatori di tutti i thread (ciascuno alla sua registrazione successiva)
+PSICRO_EXPORT void PSICRO_CALL psicro_trace_reset(void);
+
+#endif
@@ -0,0 +1,108 @@
+#include "psicro_units.h"
+#include <math.h>
+
+#define TILE 256   // Righe convertite per volta (3 x 2 KB sullo stack, restano in L1)
+
+// --- COEFFICIENTI DI CONVERSIONE ---
+// Ogni grandezza è affine: si = a * v + b, v = (si - b) / a
+typedef struct {
+    double a, b;
+} affine;
+
+static affine coeff(int prop, int unita) {
+    affine c = { 1.0, 0.0 };
+    switch (prop) {
+    case PSICRO_T:
+    case PSICRO_TBU:
+    case PSICRO_TR:
+        if (unita & PSICRO_U_IP) {
+            c.a = 1.0 / 1.8;
+            c.b = -32.0 / 1.8;
+        }
+        break;
+    case PSICRO_X:
+        if (unita & PSICRO_U_GRANI) c.a = 1.0 / 7000.0; // lb/lb e kg/kg coincidono
+        break;
+    case PSICRO_H:
+        if (unita & PSICRO_U_IP) {
+            c.a = 2.326;
+            c.b = -PSICRO_H_OFFSET_IP;
+        }
+        break;
+    case PSICRO_VAU:
+        if (unita & PSICRO_U_IP) c.a = 0.062428;
+        break;
+    default: // ur in % in entrambi i sistemi
+        break;
+    }
+    return c;
+}
+
+PSICRO_EXPORT double PSICRO_CALL psicro_converti(int prop, double v, int unita, int verso_si) {
+    affine c = coeff(prop, unita);
+    return verso_si ? c.a * v + c.b : (v - c.b) / c.a;
+}
+
+PSICRO_EXPORT double PSICRO_CALL psicro_converti_patm(double p, int unita, int verso_si) {
+    double k = 1.0;
+    if (unita & PSICRO_U_PSI) k = 6.894757293168;
+    else if (unita & PSICRO_U_INHG) k = 3.38638;
+    return verso_si ? p * k : p / k;
+}
+
+static double patm_si(double patm, int unita) {
+    return (patm > 0.0) ? psicro_converti_patm(patm, unita, 1) : PATM;
+}
+
+PSICRO_EXPORT double PSICRO_CALL psicro_calc_unita(int target, int id1, double v1, int id2, double v2,
+    double patm, int unita) {
+    if (id1 == id2 || id1 < 0 || id1 >= PSICRO_N_PROP || id2 < 0 || id2 >= PSICRO_N_PROP || target < 0 || target >= PSICRO_N_PROP) return NAN;
+    double s1 = psicro_converti(id1, v1, unita, 1);
+    double s2 = psicro_converti(id2, v2, unita, 1);
+    double r;
+    if (target == id1 || target == id2) r = (target == id1) ? s1 : s2;
+    else {
+        // Adattatore a pressione esplicita: come psicro_calc aggiorna psicro_stato()
+        psicro_fn_p fn = psicro_funzione_p(target, id1, id2);
+        const double p = patm_si(patm, unita);
+        r = (id1 < id2) ? fn(s1, s2, p) : fn(s2, s1, p);
+    }
+    return psicro_converti(target, r, unita, 0);
+}
+
+// --- BATCH CON CONVERSIONE FUSA ---
+// Carica e converte un tile, lo calcola e riconverte l'uscita mentre è ancora in cache
+static void blocco_unita(int target, int id1, const double* v1, int id2, const double* v2, long long n,
+    double p, const affine* c1, const affine* c2, const affine* ct, double* out) {
+    double s1[TILE], s2[TILE], r[TILE];
+    const double at = 1.0 / ct->a;
+    const double bt = -ct->b / ct->a;
+    for (long long i0 = 0; i0 < n; i0 += TILE) {
+        int m = (int)((i0 + TILE < n) ? TILE : n - i0);
+        for (int i = 0; i < m; i++) {
+            s1[i] = c1->a * v1[i0 + i] + c1->b;
+            s2[i] = c2->a * v2[i0 + i] + c2->b;
+        }
+        psicro_batch_blocco(target, id1, s1, id2, s2, m, p, r);
+        for (int i = 0; i < m; i++) out[i0 + i] = at * r[i] + bt;
+    }
+}
+
+PSICRO_EXPORT int PSICRO_CALL psicro_batch_unita(int target, int id1, const double* v1, int id2, const double* v2,
+    long long n, double patm, int unita, double* out) {
+    if (!v1 || !v2 || !out || n <= 0 || id1 == id2) return PSICRO_ERR_ARG;
+    if (id1 < 0 || id1 >= PSICRO_N_PROP || id2 < 0 || id2 >= PSICRO_N_PROP || target < 0 || target >= PSICRO_N_PROP) return PSICRO_ERR_NON_SUPP;
+    const double p = patm_si(patm, unita);
+    const affine c1 = coeff(id1, unita);
+    const affine c2 = coeff(id2, unita);
+    const affine ct = coeff(target, unita);
+    const long long blocco = 4096;
+    const long long n_blocchi = (n + blocco - 1) / blocco;
+#pragma omp parallel for schedule(dynamic)
+    for (long long b = 0; b < n_blocchi; b++) {
+        long long i0 = b * blocco;
+        long long m = (i0 + blocco < n) ? blocco : n - i0;
+        blocco_unita(target, id1, v1 + i0, id2, v2 + i0, m, p, &c1, &c2, &ct, out + i0);
+    }
+    return PSICRO_OK;
+}
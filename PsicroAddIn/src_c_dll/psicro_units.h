@@ -0,0 +1,33 @@
+#ifndef PSICRO_UNITS_H
+#define PSICRO_UNITS_H
+
+#include "psicrometria.h"
+
+// --- SISTEMI DI UNITÀ ---
+// Stesse conversioni di ConvertUnit in Class1.cs, ma dentro i kernel: nei
+// batch la conversione avviene su un tile in cache tra lettura e calcolo (e tra
+// calcolo e scrittura), senza passate aggiuntive sulla memoria.
+// 'unita' è una combinazione (OR) dei flag seguenti; 0 = SI.
+#define PSICRO_U_SI     0
+#define PSICRO_U_IP     1   // t/tbu/tr [°F], h [Btu/lb] con zero a 0 °F, vau [ft³/lb]
+#define PSICRO_U_GRANI  2   // x [grani/lb] (7000 grani = 1 lb)
+#define PSICRO_U_PSI    4   // patm [psi]
+#define PSICRO_U_INHG   8   // patm [inHg a 32 °F]
+
+#define PSICRO_H_OFFSET_IP  17.88444668   // Offset ASHRAE [kJ/kg] tra zero a 0 °F e a 0 °C
+
+// Valore 'v' della grandezza 'prop' espresso in 'unita' -> SI (verso_si != 0) o viceversa
+PSICRO_EXPORT double PSICRO_CALL psicro_converti(int prop, double v, int unita, int verso_si);
+// Pressione in 'unita' -> kPa (verso_si != 0) o viceversa
+PSICRO_EXPORT double PSICRO_CALL psicro_converti_patm(double p, int unita, int verso_si);
+
+// Come psicro_calc con ingressi e uscita in 'unita'. patm nella stessa unità,
+// <= 0 -> PATM corrente; la pressione esplicita vale per tutte le coppie.
+// NAN se id1 == id2 o un indice è fuori campo.
+PSICRO_EXPORT double PSICRO_CALL psicro_calc_unita(int target, int id1, double v1, int id2, double v2,
+	double patm, int unita);
+// Come psicro_batch con ingressi e uscite in 'unita'
+PSICRO_EXPORT int PSICRO_CALL psicro_batch_unita(int target, int id1, const double* v1, int id2, const double* v2,
+	long long n, double patm, int unita, double* out);
+
+#endif
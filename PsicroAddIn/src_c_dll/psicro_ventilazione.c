@@ -0,0 +1,77 @@
+#define PSICRO_SENZA_CONTEGGIO
+#include "psicro_ventilazione.h"
+#include "psicro_core.h"
+#include <stdlib.h>
+#include <string.h>
+
+PSICRO_EXPORT int PSICRO_CALL psicro_carichi_ventilazione(int id2, const double* t_est, const double* v2, long long n_passi,
+    double passo_ore, const psicro_zona_vent* zone, int n_zone, double* sens, double* lat, psicro_vent_annuo* annuo) {
+    if (!t_est || !v2 || !zone || n_passi <= 0 || n_zone <= 0) return PSICRO_ERR_ARG;
+    if (id2 < PSICRO_UR || id2 > PSICRO_TR) return PSICRO_ERR_NON_SUPP;
+    if (passo_ore <= 0.0) passo_ore = 1.0;
+    const double patm = PATM;
+
+    // 1. Stato esterno: una volta per passo, condiviso da tutte le zone
+    double* xe = (double*)malloc((size_t)n_passi * 2 * sizeof(double));
+    if (xe == NULL) return PSICRO_ERR_MEM;
+    double* me = xe + n_passi;   // Portata massica di aria secca per 1 m³/h [kg/s]
+#pragma omp parallel for schedule(static)
+    for (long long i = 0; i < n_passi; i++) {
+        core_termini_t k;
+        core_termini(id2, t_est[i], v2[i], &k);
+        double x = core_x_coppia_t(id2, t_est[i], v2[i], &k, patm);
+        xe[i] = x;
+        me[i] = 1.0 / (3600.0 * core_target_t_x(PSICRO_VAU, t_est[i], x, k.ps_t, patm));
+    }
+
+    // 2. Zone in parallelo
+#pragma omp parallel for schedule(dynamic)
+    for (int z = 0; z < n_zone; z++) {
+        const psicro_zona_vent* zn = &zone[z];
+        const double x_min = (zn->ur_risc > 0.0) ? core_x_t_ur(zn->t_risc, zn->ur_risc, patm) : 0.0;
+        const double x_max = (zn->ur_raff < 100.0) ? core_x_t_ur(zn->t_raff, zn->ur_raff, patm) : 1e30;
+        double* zs = sens ? sens + (long long)z * n_passi : NULL;
+        double* zl = lat ? lat + (long long)z * n_passi : NULL;
+        psicro_vent_annuo a;
+        memset(&a, 0, sizeof(a));
+        for (long long i = 0; i < n_passi; i++) {
+            const double te = t_est[i], x_e = xe[i];
+            const double ti = (te < zn->t_risc) ? zn->t_risc : ((te > zn->t_raff) ? zn->t_raff : te);
+            const double xi = (x_e < x_min) ? x_min : ((x_e > x_max) ? x_max : x_e);
+            const double ts = te + zn->eff_sens * (ti - te);
+            const double xs = x_e + zn->eff_lat * (xi - x_e);
+            const double m = zn->portata * me[i];
+            const double q_s = m * (core_h_t_x(ti, xs) - core_h_t_x(ts, xs));
+            const double q_l = m * (core_h_t_x(ti, xi) - core_h_t_x(ti, xs));
+            const double q_t = q_s + q_l;
+            if (zs) zs[i] = q_s;
+            if (zl) zl[i] = q_l;
+            if (q_s > 0.0) a.risc_sens += q_s;
+            else a.raff_sens += q_s;
+            if (q_l > 0.0) a.umid += q_l;
+            else a.deum += q_l;
+            if (q_t > 0.0) {
+                a.risc_tot += q_t;
+                a.ore_risc += passo_ore;
+                if (q_t > a.picco_risc) a.picco_risc = q_t;
+            }
+            else if (q_t < 0.0) {
+                a.raff_tot += q_t;
+                a.ore_raff += passo_ore;
+                if (q_t < a.picco_raff) a.picco_raff = q_t;
+            }
+        }
+        if (annuo) {
+            // Potenze [kW] * durata del passo [h] -> energie [kWh]
+            a.risc_sens *= passo_ore;
+            a.raff_sens *= passo_ore;
+            a.umid *= passo_ore;
+            a.deum *= passo_ore;
+            a.risc_tot *= passo_ore;
+            a.raff_tot *= passo_ore;
+            annuo[z] = a;
+        }
+    }
+    free(xe);
+    return PSICRO_OK;
+}
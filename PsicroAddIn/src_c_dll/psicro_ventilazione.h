@@ -0,0 +1,39 @@
+#ifndef PSICRO_VENTILAZIONE_H
+#define PSICRO_VENTILAZIONE_H
+
+#include "psicrometria.h"
+
+// --- CARICHI DI VENTILAZIONE (ARIA ESTERNA) ---
+// Lo stato esterno (x, h, vau) si calcola una volta per passo e si riusa per
+// tutte le zone; le zone si elaborano in parallelo, ciascuna sulla propria
+// serie. Modello a banda morta: l'aria di rinnovo si porta a
+//   t_i = t_e limitata a [t_risc, t_raff]
+//   x_i = x_e limitato a [x(t_risc, ur_risc), x(t_raff, ur_raff)]
+// dopo il recuperatore (t_s = t_e + eff_sens (t_i - t_e), idem per x con eff_lat).
+// Segno dei carichi: > 0 riscaldamento / umidificazione, < 0 raffreddamento /
+// deumidificazione. sensibile + latente = totale = m (h_i - h_s).
+
+typedef struct {
+	double t_risc, ur_risc;   // Setpoint invernale [°C], [%] (ur <= 0: nessuna umidificazione)
+	double t_raff, ur_raff;   // Setpoint estivo [°C], [%] (ur >= 100: nessuna deumidificazione)
+	double portata;           // Portata d'aria esterna [m³/h] (volume alle condizioni esterne)
+	double eff_sens;          // Efficienza sensibile del recuperatore [0..1]
+	double eff_lat;           // Efficienza latente del recuperatore [0..1]
+} psicro_zona_vent;
+
+typedef struct {
+	double risc_sens, raff_sens;   // Energia sensibile [kWh] (raff_sens <= 0)
+	double umid, deum;             // Energia latente [kWh] (deum <= 0)
+	double risc_tot, raff_tot;     // Energia totale per segno [kWh]
+	double picco_risc, picco_raff; // Potenza totale di picco [kW]
+	double ore_risc, ore_raff;     // Ore con carico totale > 0 / < 0
+} psicro_vent_annuo;
+
+// id2, t_est, v2: serie esterna (t e una seconda grandezza) di n_passi valori
+// passo_ore:      durata di un passo [h] (<= 0 -> 1)
+// sens, lat:      (opz.) n_zone * n_passi potenze [kW], disposte [zona][passo]
+// annuo:          (opz.) n_zone riepiloghi
+PSICRO_EXPORT int PSICRO_CALL psicro_carichi_ventilazione(int id2, const double* t_est, const double* v2, long long n_passi,
+	double passo_ore, const psicro_zona_vent* zone, int n_zone, double* sens, double* lat, psicro_vent_annuo* annuo);
+
+#endif
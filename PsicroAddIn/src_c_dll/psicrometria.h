@@ -3,12 +3,22 @@
 
 #include <math.h>
 
+// Esportazione: stdcall + dllexport nella DLL Windows, visibilità di default nella .so
 #ifdef _WIN32
 	#include <windows.h>
+	#define PSICRO_EXPORT __declspec(dllexport)
+	#define PSICRO_CALL   WINAPI
+#else
+	#define PSICRO_EXPORT __attribute__((visibility("default")))
+	#define PSICRO_CALL
+#endif
 // La macro include il tipo 'double' per essere usata come  - PSICRO_API NomeFunzione
-	#define PSICRO_API __declspec(dllexport) double WINAPI
+#define PSICRO_API PSICRO_EXPORT double PSICRO_CALL
+// Funzioni inline dei moduli interni (MSVC in C richiede __inline)
+#ifdef _MSC_VER
+	#define PSICRO_INLINE static __inline
 #else
-	#define PSICRO_API double
+	#define PSICRO_INLINE static inline
 #endif
 
 
@@ -27,9 +37,24 @@
 // --- PUNTI DI SWITCH ---
 #define T_TRIPLO    0.01          // Punto triplo acqua [°C]
 #define P_TRIPLO    0.611657      // Pressione punto triplo [kPa]
+// --- CODICI DI RITORNO (API batch) ---
+#define PSICRO_OK           0         // Calcolo completato
+#define PSICRO_ERR_ARG     -1         // Argomenti non validi (puntatori NULL, n <= 0 ...)
+#define PSICRO_ERR_MEM     -2         // Allocazione fallita
+#define PSICRO_ERR_DATI    -3         // Nessuna riga valida
+#define PSICRO_ERR_NON_SUPP -4        // Coppia di ingresso / target non gestiti
+// --- INDICI DELLE GRANDEZZE (stessa numerazione di GetPropIndex in Class1.cs) ---
+#define PSICRO_T            0         // Temperatura bulbo secco [°C]
+#define PSICRO_UR           1         // Umidità relativa [%]
+#define PSICRO_X            2         // Titolo [kg/kg]
+#define PSICRO_H            3         // Entalpia [kJ/kg]
+#define PSICRO_VAU          4         // Volume specifico [m³/kg]
+#define PSICRO_TBU          5         // Temperatura bulbo umido [°C]
+#define PSICRO_TR           6         // Temperatura di rugiada [°C]
+#define PSICRO_N_PROP       7
 
-extern volatile double PATM;
-__declspec(dllexport) void WINAPI set_patm_at_altitude(double altitude);
+extern PSICRO_EXPORT volatile double PATM;
+PSICRO_EXPORT void PSICRO_CALL set_patm_at_altitude(double altitude);
 //void get_patm_at_altitude(double altitude);
 PSICRO_API Psat(double t);
 PSICRO_API TPsat(double p_kpa);
@@ -140,4 +165,30 @@ PSICRO_API tr_x_tbu(double x, double tbu);
 PSICRO_API tr_h_vau(double h, double vau);
 PSICRO_API tr_h_tbu(double h, double tbu);
 PSICRO_API tr_vau_tbu(double vau, double tbu);
+
+// --- SELEZIONE PER INDICI (psicro_dispatch.c) ---
+typedef double (PSICRO_CALL *psicro_fn)(double, double);
+psicro_fn psicro_funzione(int target, int id1, int id2); // NULL se target coincide con un ingresso
+// Stessa funzione a pressione esplicita; azzera lo stato del thread come le esportate (uso interno)
+typedef double (*psicro_fn_p)(double, double, double);
+psicro_fn_p psicro_funzione_p(int target, int id1, int id2);
+PSICRO_API psicro_calc(int target, int id1, double v1, int id2, double v2);
+// out[i] = target(v1[i], v2[i]) alla PATM corrente, in parallelo
+PSICRO_EXPORT int PSICRO_CALL psicro_batch(int target, int id1, const double* v1, int id2, const double* v2,
+	long long n, double* out);
+// Stato (t, x) da una coppia qualsiasi con il solutore generico (psicro_core.h);
+// PSICRO_ERR_NON_SUPP per (x, tr), che non determina t
+PSICRO_EXPORT int PSICRO_CALL psicro_stato_tx(int id1, double v1, int id2, double v2, double* t, double* x);
+// Come psicro_calc passando per il solutore generico; NAN se la coppia non determina lo stato.
+// Per le coppie senza t il risultato differisce da psicro_calc entro le tolleranze
+// dei due percorsi (es. *_x_tr, degeneri, qui sono NAN)
+PSICRO_API psicro_calc_tx(int target, int id1, double v1, int id2, double v2);
+// Come psicro_batch con il solutore generico: out[i] = psicro_calc_tx(...)
+PSICRO_EXPORT int PSICRO_CALL psicro_batch_tx(int target, int id1, const double* v1, int id2, const double* v2,
+	long long n, double* out);
+// Versioni seriali con pressione esplicita, senza stato del thread (uso interno, psicro_batch.c)
+void psicro_batch_blocco(int target, int id1, const double* v1, int id2, const double* v2,
+	long long n, double patm, double* out);
+void psicro_batch_tx_blocco(int target, int id1, const double* v1, int id2, const double* v2,
+	long long n, double patm, double* out);
 #endif
\ No newline at end of file
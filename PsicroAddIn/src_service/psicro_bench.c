@@ -0,0 +1,110 @@
+// Misura del throughput del demone psicrod (Linux / POSIX).
+// Uso: psicro_bench [-s socket] [-c client] [-n righe] [-r ripetizioni] [-slot n] [-righe_slot n]
+// Ogni client apre la propria regione condivisa e invia lo stesso batch
+// (t, ur) -> tr e (h, ur) -> tbu; a confronto psicro_batch nel processo.
+#include "../src_c_dll/psicro_service.h"
+#include "../src_c_dll/psicro_thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char* socket_path;
+    int n_slot, righe_slot, ripetizioni;
+    int target, id1, id2;
+    const double *v1, *v2;
+    double* out;
+    long long n;
+    int stato;
+} lavoro_client;
+
+static psicro_thread_ret PSICRO_THREAD_FN esegui_client(void* arg) {
+    lavoro_client* l = (lavoro_client*)arg;
+    psicro_client* c = psicro_client_apri(l->socket_path, l->n_slot, l->righe_slot);
+    if (c == NULL) {
+        l->stato = PSICRO_ERR_ARG;
+        return 0;
+    }
+    for (int r = 0; r < l->ripetizioni && l->stato == PSICRO_OK; r++) {
+        l->stato = psicro_client_batch(c, l->target, l->id1, l->v1, l->id2, l->v2, l->n, 0.0, l->out);
+    }
+    psicro_client_chiudi(c);
+    return 0;
+}
+
+static void misura(const char* nome, const char* socket_path, int n_client, int n_slot, int righe_slot,
+    int ripetizioni, int target, int id1, const double* v1, int id2, const double* v2, long long n) {
+    lavoro_client l[64];
+    psicro_thread_t th[64];
+    double* rif = (double*)malloc((size_t)n * sizeof(double));
+    if (rif == NULL) return;
+
+    unsigned long long t0 = psicro_ora_ns();
+    for (int r = 0; r < ripetizioni; r++) psicro_batch(target, id1, v1, id2, v2, n, rif);
+    double s_locale = (double)(psicro_ora_ns() - t0) * 1e-9;
+
+    int partiti = 0;
+    t0 = psicro_ora_ns();
+    for (int k = 0; k < n_client; k++) {
+        lavoro_client lk = { socket_path, n_slot, righe_slot, ripetizioni, target, id1, id2, v1, v2, NULL, n, PSICRO_OK };
+        l[k] = lk;
+        l[k].out = (double*)malloc((size_t)n * sizeof(double));
+        if (l[k].out == NULL || !psicro_thread_create(&th[k], esegui_client, &l[k])) {
+            free(l[k].out);
+            break;
+        }
+        partiti++;
+    }
+    for (int k = 0; k < partiti; k++) psicro_thread_join(th[k]);
+    double s_servizio = (double)(psicro_ora_ns() - t0) * 1e-9;
+
+    int errori = 0;
+    long long diverse = 0;
+    for (int k = 0; k < partiti; k++) {
+        if (l[k].stato != PSICRO_OK) errori++;
+        else for (long long i = 0; i < n; i++) if (memcmp(&l[k].out[i], &rif[i], sizeof(double)) != 0) diverse++;
+        free(l[k].out);
+    }
+    const double righe = (double)n * ripetizioni;
+    printf("%-12s locale %8.2f Mrighe/s | servizio %d client %8.2f Mrighe/s aggregati | errori %d, righe diverse %lld\n",
+        nome, righe / s_locale * 1e-6, partiti, righe * partiti / s_servizio * 1e-6, errori, diverse);
+    free(rif);
+}
+
+int main(int argc, char** argv) {
+    const char* socket_path = PSICRO_SVC_SOCKET;
+    int n_client = 4, ripetizioni = 5, n_slot = 8, righe_slot = 65536;
+    long long n = 1000000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-s") == 0) socket_path = argv[i + 1];
+        else if (strcmp(argv[i], "-c") == 0) n_client = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-n") == 0) n = atoll(argv[i + 1]);
+        else if (strcmp(argv[i], "-r") == 0) ripetizioni = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-slot") == 0) n_slot = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-righe_slot") == 0) righe_slot = atoi(argv[i + 1]);
+        else {
+            fprintf(stderr, "uso: %s [-s socket] [-c client] [-n righe] [-r ripetizioni] [-slot n] [-righe_slot n]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (n_client < 1 || n_client > 64 || n <= 0 || ripetizioni < 1) return 2;
+
+    // Stati su -10..40 °C, 10..95 %: pochi valori distinti, come le serie reali
+    double* t = (double*)malloc((size_t)n * sizeof(double));
+    double* ur = (double*)malloc((size_t)n * sizeof(double));
+    double* h = (double*)malloc((size_t)n * sizeof(double));
+    if (!t || !ur || !h) return 1;
+    for (long long i = 0; i < n; i++) {
+        t[i] = -10.0 + 0.1 * (double)(i % 501);
+        ur[i] = 10.0 + 0.5 * (double)((i / 501) % 171);
+        h[i] = h_t_ur(t[i], ur[i]);
+    }
+    printf("psicro_bench: %lld righe x %d ripetizioni, %d slot da %d righe, PATM %.3f kPa\n",
+        n, ripetizioni, n_slot, righe_slot, PATM);
+    misura("tr(t, ur)", socket_path, n_client, n_slot, righe_slot, ripetizioni, PSICRO_TR, PSICRO_T, t, PSICRO_UR, ur, n);
+    misura("tbu(h, ur)", socket_path, n_client, n_slot, righe_slot, ripetizioni, PSICRO_TBU, PSICRO_H, h, PSICRO_UR, ur, n);
+    free(t);
+    free(ur);
+    free(h);
+    return 0;
+}
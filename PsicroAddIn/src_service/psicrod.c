@@ -0,0 +1,33 @@
+// Demone di calcolo psicrometrico locale (Linux / POSIX).
+// Uso: psicrod [-s socket] [-t thread] [-q quota_m]
+#include "../src_c_dll/psicro_service.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void su_segnale(int sig) {
+    (void)sig;
+    psicro_service_ferma();
+}
+
+int main(int argc, char** argv) {
+    const char* socket_path = PSICRO_SVC_SOCKET;
+    int n_thread = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-s") == 0) socket_path = argv[i + 1];
+        else if (strcmp(argv[i], "-t") == 0) n_thread = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-q") == 0) set_patm_at_altitude(atof(argv[i + 1]));
+        else {
+            fprintf(stderr, "uso: %s [-s socket] [-t thread] [-q quota_m]\n", argv[0]);
+            return 2;
+        }
+    }
+    signal(SIGINT, su_segnale);
+    signal(SIGTERM, su_segnale);
+    signal(SIGPIPE, SIG_IGN);
+    fprintf(stderr, "psicrod: %s (PATM %.3f kPa)\n", socket_path, PATM);
+    int stato = psicro_service_avvia(socket_path, n_thread);
+    if (stato != PSICRO_OK) fprintf(stderr, "psicrod: errore %d\n", stato);
+    return (stato == PSICRO_OK) ? 0 : 1;
+}